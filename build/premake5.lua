@@ -64,6 +64,9 @@ function build_externals()
 end
 
 function platform_defines()
+    -- raylib's EndDrawing neither waits nor polls input, FramePacer does (game and raylib must agree)
+    defines{"SUPPORT_CUSTOM_FRAME_CONTROL"}
+
     filter {"configurations:Debug or Release"}
         defines{"PLATFORM_DESKTOP"}
 
@@ -241,6 +244,88 @@ end
         filter{}
         
 
+    project "racing-batch"
+        kind "ConsoleApp"
+        location "build_files/"
+        targetdir "../bin/%{cfg.buildcfg}"
+
+        -- The whole game minus its entry point, plus the batch runner's own main
+        vpaths
+        {
+            ["Header Files"] = { "../include/**.h", "../include/**.hpp" },
+            ["Source Files"] = { "../src/**.cpp", "../tools/racing-batch/**.cpp" },
+        }
+        files {"../src/**.cpp", "../include/**.h", "../include/**.hpp", "../tools/racing-batch/**.cpp"}
+        removefiles {"../src/core/Main.cpp"}
+
+        includedirs { "../src" }
+        includedirs { "../include" }
+
+        links {"raylib"}
+
+        if (downloadBox2D) then
+            links {"box2d"}
+        end
+
+        cdialect "C17"
+        cppdialect "C++17"
+
+        includedirs {raylib_dir .. "/src" }
+        includedirs {raylib_dir .."/src/external" }
+        includedirs { raylib_dir .."/src/external/glfw/include" }
+
+        if (downloadBox2D) then
+            includedirs {box2d_dir .. "/include" }
+        end
+        platform_defines()
+
+        filter "action:vs*"
+            defines{"_WINSOCK_DEPRECATED_NO_WARNINGS", "_CRT_SECURE_NO_WARNINGS"}
+            dependson {"raylib"}
+            links {"raylib.lib"}
+            if (downloadBox2D) then
+                dependson {"box2d"}
+                links {"box2d.lib"}
+            end
+            characterset ("Unicode")
+            buildoptions { "/Zc:__cplusplus" }
+
+        filter "system:windows"
+            defines{"_WIN32"}
+            links {"winmm", "gdi32", "opengl32"}
+            libdirs {"../bin/%{cfg.buildcfg}"}
+
+        filter "system:linux"
+            links {"pthread", "m", "dl", "rt", "X11"}
+
+        filter "system:macosx"
+            links {"OpenGL.framework", "Cocoa.framework", "IOKit.framework", "CoreFoundation.framework", "CoreAudio.framework", "CoreVideo.framework", "AudioToolbox.framework"}
+
+        filter{}
+
+    project "logdecode"
+        kind "ConsoleApp"
+        location "build_files/"
+        targetdir "../bin/%{cfg.buildcfg}"
+
+        language "C++"
+        cppdialect "C++17"
+
+        vpaths
+        {
+            ["Header Files"] = { "../include/core/LogFormat.h" },
+            ["Source Files"] = { "../tools/logdecode/**.cpp", "../src/core/LogFormat.cpp" },
+        }
+        files {"../tools/logdecode/**.cpp", "../src/core/LogFormat.cpp", "../include/core/LogFormat.h"}
+
+        includedirs { "../include" }
+
+        filter "action:vs*"
+            defines{"_CRT_SECURE_NO_WARNINGS"}
+            characterset ("Unicode")
+            buildoptions { "/Zc:__cplusplus" }
+        filter{}
+
     project "raylib"
         kind "StaticLib"
     
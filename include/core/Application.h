@@ -2,9 +2,18 @@
 
 #include "core/Globals.h"
 #include "core/Timer.h"
+#include "core/Profiler.h"
+#include "core/InputRecorder.h"
+#include "core/Random.h"
+#include "core/MemoryTracker.h"
+#include "core/FramePacer.h"
+#include "core/QualityGovernor.h"
+#include "core/StateHash.h"
+#include <stdint.h>
 #include <vector>
 
 class Module;
+class StateWriter;
 class ModuleWindow;
 class ModuleRender;
 class ModuleAudio;
@@ -17,6 +26,10 @@ class ModuleIntro;
 class NPCManager;
 class Map;
 class CheckpointManager;
+class JobSystem;
+class CarStore;
+class EventBus;
+class TrackCache;
 
 enum GameState
 {
@@ -25,6 +38,49 @@ enum GameState
     GAME_PLAYING
 };
 
+// Startup options (filled from the command line in Main.cpp)
+struct AppConfig
+{
+	// No window, audio or GPU - the race is simulated as fast as the CPU allows
+	bool headless = false;
+
+	// Headless only: stop after this many simulation steps (0 = HEADLESS_DEFAULT_STEPS)
+	uint64 maxSteps = 0;
+
+	// Write a chrome://tracing JSON of the last seconds to this file on exit (nullptr = off)
+	const char* tracePath = nullptr;
+
+	// Job system worker threads (-1 = one less than the hardware threads, 0 = main thread only)
+	int workerThreads = -1;
+
+	// Random seed for the race (0 = pick one from the clock)
+	uint32 randomSeed = 0;
+
+	// Headless only: the player's car is left out and only NPCs race (racing-batch)
+	// The run ends once every NPC has finished
+	bool aiOnly = false;
+
+	// Record the player's input to this file / play it back instead of the keyboard (nullptr = off)
+	const char* recordPath = nullptr;
+	const char* replayPath = nullptr;
+
+	// Hash the simulation state after every step (see GetStateHash), and write the hashes
+	// to a file / compare them with one written earlier (nullptr = off, either turns hashing on)
+	bool stateHash = false;
+	const char* hashLogPath = nullptr;
+	const char* hashCheckPath = nullptr;
+
+	// When frames read input and present (F3 cycles at runtime), and the most frames per second (0 = no cap)
+	FramePacing framePacing = FRAME_PACING_VSYNC;
+	int frameCap = 60;
+
+	// Simulated seconds per real second, 1..MAX_TIME_SCALE (F6 doubles it at runtime)
+	int timeScale = 1;
+
+	// Fixed quality level, or QUALITY_LEVEL_COUNT to follow the frame budget (see QualityGovernor)
+	QualityLevel quality = QUALITY_LEVEL_COUNT;
+};
+
 class Application
 {
 public:
@@ -42,31 +98,231 @@ public:
 	ModuleMainMenu* mainMenu;
 	ModuleIntro* intro;
 
+	// Thread pool shared by all modules for per-frame entity work
+	JobSystem* jobs;
+
+	// Hot state of every car (Car objects are views into it)
+	CarStore* cars;
+
+	// Gameplay events, delivered in batches (see EventBus)
+	EventBus* events;
+
+	// Parsed tracks, kept between races (see TrackCache)
+	TrackCache* tracks;
+
 	GameState state = GAME_INTRO;
 
 private:
 
+	AppConfig config;
 	std::vector<Module*> list_modules;
 	uint64 frame_count = 0;
 
-	Timer ptimer;
+	Profiler profiler;
+	FramePacer frame_pacer;
+	QualityGovernor quality_governor;
+	InputRecorder input_recorder;
+	uint32 random_seed = 0;
+	Random random;
+
+	// Chained state hash of the race so far, and the buffer the state is serialized into
+	bool state_hash_enabled = false;
+	uint64_t state_hash = 0;
+	std::vector<uint8_t> hash_buffer;
+	StateHashLog hash_log;
 	Timer startup_time;
 	Timer frame_time;
 	Timer last_sec_frame_time;
 
+	// Seconds between the starts of the last two frames (see GetFrameDelta)
+	float frame_delta = 0.0f;
+
+	// Startup counters, see GetTimeToFirstFrame / GetTimeToRaceStart
+	double time_to_first_frame = 0.0;
+	double time_to_race_start = 0.0;
+	Timer race_start_time;
+	bool race_start_pending = false;
+
+	// Heap allocations per subsystem (see MemoryTracker.h)
+	MemoryCounters memory_frame_start;
+	MemoryCounters memory_frame;        // last finished frame
+	MemoryCounters memory_race;         // race frames after MEMORY_WARMUP_FRAMES, summed
+	uint64 race_frames = 0;
+	uint64 memory_race_frames = 0;
+	uint64 memory_race_frames_allocating = 0;
+
 	uint32 last_sec_frame_count = 0;
 	uint32 prev_last_sec_frame_count = 0;
 
+	// Fixed timestep simulation
+	float fixed_accumulator = 0.0f;
+	float interpolation_alpha = 1.0f;
+	uint64 simulation_steps = 0;
+	int time_scale = 1;
+
+	// Module task graph, built once by BuildSchedule()
+	// Segments run in order. A barrier module is a segment of its own; inside any other
+	// segment a module may start as soon as the modules it depends on have finished
+	struct ScheduleNode
+	{
+		int module;                     // index into list_modules
+		std::vector<int> dependencies;  // nodes of the same segment that must finish first
+		int wave;                       // one past the latest wave among its dependencies
+	};
+	struct ScheduleSegment
+	{
+		std::vector<ScheduleNode> nodes;
+		std::vector<std::vector<int>> waves;   // nodes by wave - a wave only depends on earlier ones
+	};
+	std::vector<ScheduleSegment> schedule;
+
+	// F5 / F9 quick save slot
+	std::vector<uint8_t> quick_save;
+
+	// The race as StartRace left it, for RestartRace
+	std::vector<uint8_t> race_start_state;
+
+	// Headless run statistics
+	Timer headless_time;
+
 public:
 
-	Application();
+	Application(const AppConfig& appConfig = AppConfig());
 	~Application();
 
 	bool Init();
 	update_status Update();
 	bool CleanUp();
 
+	// Enable the game modules in dependency order and switch to GAME_PLAYING
+	void StartRace();
+
+	// Put the race back where StartRace left it - cars, checkpoints, abilities, timers and
+	// the RNG - without touching the world, the map or loaded resources (R in a race)
+	// Refused while recording or replaying input, which can only run one race from its start
+	bool RestartRace();
+
+	// Leave the race for the main menu (Escape in a race). The parsed track stays in
+	// the track cache, so the next StartRace doesn't read or parse it again
+	void ReturnToMenu();
+
+	const AppConfig& GetConfig() const { return config; }
+	bool IsHeadless() const { return config.headless; }
+	bool IsAIOnly() const { return config.headless && config.aiOnly; }
+
+	// Number of fixed simulation steps run since startup
+	uint64 GetSimulationStep() const { return simulation_steps; }
+
+	// Player input recording / replay (see --record and --replay)
+	InputRecorder& GetInputRecorder() { return input_recorder; }
+
+	// Seed the race RNG was started with
+	uint32 GetRandomSeed() const { return random_seed; }
+
+	// Race-wide RNG stream for simulation decisions - seeded by StartRace, main thread only
+	// Entities with their own decisions seed a stream of their own from GetRandomSeed
+	Random& GetRandom() { return random; }
+
+	// Whole simulation snapshot: step counter plus the state of every enabled module
+	// Entities and physics bodies are kept, restoring only overwrites their state,
+	// so both are cheap enough to call every step. Reusing the buffer avoids allocations.
+	// LoadState returns false (leaving the world partly restored) if the snapshot
+	// was taken with different entities, e.g. before a module was enabled.
+	// A restore is NOT bit-exact: Box2D's contacts, warm-start impulses and broadphase
+	// tree aren't part of the snapshot. Loading drops the restored bodies' contacts so
+	// none survive from before the load, but the order Box2D finds them again follows
+	// the tree's history, so steps after a load can drift from the original run.
+	void SaveState(std::vector<uint8_t>& buffer) const;
+	bool LoadState(const std::vector<uint8_t>& buffer);
+
+	// XXH64 chain over the simulation state after each step since StartRace: every step
+	// hashes the snapshot contents (RNG, bodies, cars, AI, checkpoints) seeded with the
+	// previous hash, so one diverging step changes every hash after it. Frame timing isn't
+	// part of it - on one platform and toolchain, equal hashes mean equal races whatever
+	// the frame rate or thread count. Snapshots carry the chain, but as restores aren't
+	// bit-exact, hashes after a load aren't comparable with an uninterrupted run.
+	// 0 when hashing is off (AppConfig::stateHash).
+	uint64_t GetStateHash() const { return state_hash; }
+
+	// Per-module frame timings (rolling min/avg/p99)
+	const Profiler& GetProfiler() const { return profiler; }
+
+	// Input sampling and presentation timing (see FramePacer)
+	FramePacer& GetFramePacer() { return frame_pacer; }
+	const FramePacer& GetFramePacer() const { return frame_pacer; }
+
+	// Optional work for this frame - particles, background, debug draw, solver iterations, NPC rays
+	// Changes only between frames, so jobs may read it while the frame runs
+	const QualitySettings& GetQuality() const { return quality_governor.GetSettings(); }
+	const QualityGovernor& GetQualityGovernor() const { return quality_governor; }
+
+	// Frames completed in the last full second
+	uint32 GetFramesLastSecond() const { return prev_last_sec_frame_count; }
+	uint64 GetFrameCount() const { return frame_count; }
+
+	// Startup timings in seconds, 0 until reached
+	// First frame: from construction until the first frame is finished
+	// Race start: from StartRace() until the first race frame is finished
+	double GetTimeToFirstFrame() const { return time_to_first_frame; }
+	double GetTimeToRaceStart() const { return time_to_race_start; }
+
+	// Heap allocations of the last frame per subsystem (live bytes: current totals)
+	const MemoryCounters& GetFrameMemory() const { return memory_frame; }
+
+	// Allocations in race frames after the warm-up - should stay at zero
+	const MemoryCounters& GetRaceMemory() const { return memory_race; }
+	uint64 GetRaceFramesMeasured() const { return memory_race_frames; }
+	uint64 GetRaceFramesAllocating() const { return memory_race_frames_allocating; }
+
+	// Log the allocation counters, e.g. at the end of a headless run
+	void LogMemoryReport() const;
+
+	// Length of one simulation step in seconds
+	float GetFixedDeltaTime() const { return FIXED_TIMESTEP; }
+
+	// Fast-forward: simulation steps run time_scale times as fast as real time, frames
+	// are still rendered once. Anything that is part of the race (timers, countdowns,
+	// abilities) must advance in FixedUpdate to follow it; frame deltas stay real time.
+	// Has no effect headless, where every Update is exactly one step anyway.
+	int GetTimeScale() const { return time_scale; }
+	void SetTimeScale(int scale);
+
+	// Length of the previous frame in seconds, from this Application's own clock
+	// Use it instead of raylib's GetFrameTime(), which is shared by the whole process.
+	// Clamped to MAX_FRAME_TIME; headless frames are exactly one simulation step.
+	float GetFrameDelta() const { return frame_delta; }
+
+	// Keyboard state of this Application's window - always up when headless
+	// Modules ask here instead of calling raylib directly, so Applications without
+	// a window (racing-batch runs several per process) never see the real keyboard
+	bool IsKeyDown(int key) const;
+	bool IsKeyPressed(int key) const;
+
+	// How far the current frame is between the last two simulation steps (0..1)
+	// Used to interpolate rendered transforms
+	float GetInterpolationAlpha() const { return interpolation_alpha; }
+
 private:
 
-	void AddModule(Module* module);
+	void AddModule(Module* module, const char* name, MemoryTag memoryTag);
+
+	// Window, audio, rendering and menus - skipped entirely in headless mode
+	bool IsPresentationModule(const Module* module) const;
+
+	update_status UpdateHeadless();
+
+	// Module phase dispatch - every call is timed into the profiler
+	update_status RunPhaseOnModules(ProfilePhase phase);
+	update_status RunSegment(const ScheduleSegment& segment, ProfilePhase phase);
+	void BuildSchedule();
+	update_status RunPhase(Module* module, ProfilePhase phase, int slot = -1);
+	void FinishFrame(bool raceFrame);
+
+	// The part of a snapshot that is simulation state, and the per-step hash over it
+	void WriteSimulationState(StateWriter& writer) const;
+	// false once --hash-check has found a mismatch
+	bool UpdateStateHash();
+
+	// F5 / F9 in a race
+	void HandleQuickSave();
 };
\ No newline at end of file
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "core/Globals.h"
+#include <mutex>
+#include <vector>
+
+class PhysBody;
+class ModuleRender;
+class ModuleAudio;
+
+// Events each queue holds between two dispatches. Screen shakes and sounds are cosmetic:
+// past the capacity they are dropped (and counted). Contacts change the race, so they are
+// never dropped - the rest spill into a list that grows (and is counted)
+#define MAX_CONTACT_EVENTS 256
+#define MAX_SCREEN_SHAKE_EVENTS 32
+#define MAX_SOUND_EVENTS 32
+
+// Two bodies started or stopped touching (Box2D BeginContact / EndContact)
+struct ContactEvent
+{
+	PhysBody* bodyA;
+	PhysBody* bodyB;
+	bool begin;
+};
+
+struct ScreenShakeEvent
+{
+	float amount;
+};
+
+// A sound effect loaded with ModuleAudio::LoadFx
+struct SoundEvent
+{
+	unsigned int fxId;
+};
+
+// Fixed-capacity event array - never allocates, cleared by its bus after dispatch
+template <typename T, int Capacity>
+class EventQueue
+{
+public:
+	bool Push(const T& event)
+	{
+		if (count == Capacity)
+		{
+			dropped++;
+			return false;
+		}
+		events[count++] = event;
+		return true;
+	}
+
+	bool IsFull() const { return count == Capacity; }
+	int GetCount() const { return count; }
+	T& operator[](int index) { return events[index]; }
+	const T& operator[](int index) const { return events[index]; }
+
+	// Dropped since the last TakeDropped()
+	uint32 TakeDropped()
+	{
+		uint32 ret = dropped;
+		dropped = 0;
+		return ret;
+	}
+
+	void Clear() { count = 0; }
+
+private:
+	T events[Capacity];
+	int count = 0;
+	uint32 dropped = 0;
+};
+
+// What the bus carried over one frame
+struct EventStats
+{
+	uint32 contacts = 0;
+	uint32 screenShakes = 0;
+	uint32 sounds = 0;
+	uint32 dropped = 0;
+	uint32 contactSpills = 0;  // Contacts past MAX_CONTACT_EVENTS, still delivered
+	double dispatchMs = 0.0;   // Time spent in the listeners, renderer and audio
+};
+
+// EventBus: Gameplay side effects, buffered and delivered in batches
+// Systems post events instead of calling each other; the bus hands them over at fixed
+// sync points, in the order they were posted:
+//   - contacts: ModulePhysics, right after each world step (never inside b2World::Step)
+//   - screen shakes and sounds: Application, once per frame between Update and PostUpdate
+// Screen shakes and sounds may be posted from any thread. Emitters still declare Writes on
+// the module that ends up consuming them (renderer...), which keeps them ordered by the
+// schedule and the delivery order deterministic. Contacts come from Box2D callbacks, so
+// only the thread stepping the world posts, purges and dispatches them.
+class EventBus
+{
+public:
+	void PostContact(PhysBody* bodyA, PhysBody* bodyB, bool begin);
+	void PostScreenShake(float amount);
+	void PostSound(unsigned int fxId);
+
+	// Forget queued contacts with a body that is about to be deleted
+	void PurgeBody(const PhysBody* body);
+
+	// Sync points
+	void DispatchContacts();
+	void DispatchFrameEvents(ModuleRender* renderer, ModuleAudio* audio);
+
+	// Drop everything queued (the world and its bodies are going away)
+	void Clear();
+
+	// Stats restart with every frame
+	void BeginFrame();
+	const EventStats& GetFrameStats() const { return lastFrame; }
+
+private:
+	// Queued contacts, spilled ones included
+	int GetContactCount() const { return contacts.GetCount() + (int)contactSpill.size(); }
+	ContactEvent& GetContact(int index);
+
+	std::mutex mutex;
+
+	EventQueue<ContactEvent, MAX_CONTACT_EVENTS> contacts;
+	std::vector<ContactEvent> contactSpill;   // after contacts, in posting order - allocates, but only on overflow
+	EventQueue<ScreenShakeEvent, MAX_SCREEN_SHAKE_EVENTS> screenShakes;
+	EventQueue<SoundEvent, MAX_SOUND_EVENTS> sounds;
+
+	EventStats frame;
+	EventStats lastFrame;
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "core/Globals.h"
+#include "core/Timer.h"
+#include <stdint.h>
+
+// Frames whose work is remembered to predict the next one (just-in-time pacing)
+#define PACER_WORK_HISTORY 32
+// Slack left between the predicted end of a frame's work and the vertical blank
+#define PACER_SAFETY_MARGIN_MS 1.5
+// Weight of the newest frame in the averaged stats
+#define PACER_STATS_SMOOTHING 0.05
+// Frame rate while a menu has nothing new to show - still enough to react to input and to
+// keep the music stream fed
+#define PACER_IDLE_FPS 30
+
+enum FramePacing : uint8_t
+{
+	FRAME_PACING_VSYNC,         // vsync plus the frame cap - the classic loop
+	FRAME_PACING_JUST_IN_TIME,  // vsync, sleeps after presenting so input is read as late as the work allows
+	FRAME_PACING_UNCAPPED,      // no vsync, only the frame cap (0 = none) - lowest latency, may tear
+	FRAME_PACING_COUNT
+};
+
+// FramePacer: Decides when a frame reads its input and when it is presented
+// With raylib built with SUPPORT_CUSTOM_FRAME_CONTROL (see build/premake5.lua) EndDrawing
+// neither waits nor polls input, so the pacer does both: BeginFrame sleeps as the mode asks
+// and then polls, Present swaps the buffers. Everything the game reads from the keyboard is
+// frozen at that poll, so the later it happens the fresher the frame's input.
+// Without custom frame control raylib paces inside EndDrawing and just-in-time isn't available.
+class FramePacer
+{
+public:
+	// Once the window exists
+	void Init(FramePacing mode, int frameCap);
+
+	void SetMode(FramePacing mode);
+	void NextMode();
+	FramePacing GetMode() const { return mode; }
+	int GetFrameCap() const { return frameCap; }
+
+	static const char* GetModeName(FramePacing mode);
+	static bool IsModeAvailable(FramePacing mode);
+
+	// Idle frames are capped at PACER_IDLE_FPS whatever the mode, saving power on static screens
+	void SetIdle(bool idle);
+	bool IsIdle() const { return idle; }
+
+	// Start of a frame: sleep as the mode asks, then read input
+	void BeginFrame();
+
+	// End of a frame: finish drawing and show it
+	void Present();
+
+	// Averaged over recent frames, in milliseconds
+	double GetWorkMs() const { return workMs; }                     // input read until present
+	double GetSleepMs() const { return sleepMs; }                   // slept before reading input
+	double GetInputToPresentMs() const { return inputToPresentMs; } // input read until the swap returned
+
+	// Work of the last presented frame alone, in milliseconds
+	double GetLastWorkMs() const { return lastWorkMs; }
+
+	// Time one frame may take at the rate the mode aims for: the refresh rate with vsync,
+	// the frame cap when that is lower (or when uncapped)
+	double GetFrameBudgetMs() const;
+
+private:
+	double PredictWorkSec() const;
+	int GetIdleCap() const;
+	void Sleep(double seconds);
+
+	FramePacing mode = FRAME_PACING_VSYNC;
+	int frameCap = 0;
+	bool windowReady = false;
+	bool idle = false;
+
+	uint64_t inputAt = 0;       // last input poll (clock ticks)
+	uint64_t presentedAt = 0;   // last swap returned
+	bool havePresented = false;
+
+	float workHistory[PACER_WORK_HISTORY] = {};
+	int workIndex = 0;
+
+	double workMs = 0.0;
+	double lastWorkMs = 0.0;
+	double sleepMs = 0.0;
+	double inputToPresentMs = 0.0;
+};
@@ -4,9 +4,7 @@
 
 #include <stdio.h>
 
-#define LOG(format, ...) log(__FILE__, __LINE__, format, __VA_ARGS__);
-
-void log(const char file[], int line, const char* format, ...);
+#include "core/Log.h"
 
 #define CAP(n) ((n <= 0.0f) ? n=0.0f : (n >= 1.0f) ? n=1.0f : n=n)
 
@@ -38,4 +36,9 @@ enum update_status
 #define WIN_BORDERLESS		false
 #define WIN_FULLSCREEN_DESKTOP false
 #define VSYNC				true
+#define FIXED_TIMESTEP		(1.0f / 60.0f)
+#define MAX_FIXED_STEPS		5		// Steps per frame before the simulation drops time (times the time scale)
+#define MAX_TIME_SCALE		16		// Fastest fast-forward: simulated seconds per real second
+#define MAX_FRAME_TIME		0.25f	// Longest frame fed into the accumulator (seconds)
+#define HEADLESS_DEFAULT_STEPS	(60 * 60 * 10)	// 10 simulated minutes
 #define TITLE "Luma Grand Prix"
\ No newline at end of file
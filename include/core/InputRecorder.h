@@ -0,0 +1,70 @@
+#pragma once
+
+#include "core/Globals.h"
+#include <stdint.h>
+
+// Replay file: INPUT_FILE_MAGIC (8 bytes), seed u32, then runs of (input u8, steps u16)
+// until the end of the file. One input per simulation step while the race is running.
+#define INPUT_FILE_MAGIC "LGPREC1"
+#define INPUT_FILE_MAGIC_SIZE 8
+
+// Longest run stored in one record, longer runs are split
+#define INPUT_MAX_RUN 0xFFFF
+
+// Player controls sampled for one simulation step (bit flags)
+enum PlayerInputFlags
+{
+	INPUT_ACCELERATE  = 1 << 0,
+	INPUT_REVERSE     = 1 << 1,
+	INPUT_STEER_LEFT  = 1 << 2,
+	INPUT_STEER_RIGHT = 1 << 3,
+	INPUT_PUSH        = 1 << 4
+};
+
+typedef uint8_t PlayerInput;
+
+// InputRecorder: Writes the player's per-step input to a file, or feeds it back
+// Together with the fixed timestep and the recorded RNG seed, playing a file back
+// reproduces the recorded race step for step - in a window or headless
+class InputRecorder
+{
+public:
+	InputRecorder();
+	~InputRecorder();
+
+	bool StartRecording(const char* path, uint32 seed);
+	bool StartPlayback(const char* path);
+	void Close();
+
+	bool IsRecording() const { return file != nullptr && recording; }
+	bool IsPlaying() const { return file != nullptr && !recording; }
+
+	// Playback ran out of recorded steps
+	bool IsFinished() const { return finished; }
+
+	// Seed stored in the file being played (or recorded)
+	uint32 GetSeed() const { return seed; }
+
+	// Steps recorded or played so far
+	uint64 GetStepCount() const { return steps; }
+
+	// Recording: store this step's input
+	void Record(PlayerInput input);
+
+	// Playback: input for the next step (no input once the file is exhausted)
+	PlayerInput Next();
+
+private:
+	void WriteRun();
+
+	FILE* file = nullptr;
+	bool recording = false;
+	bool finished = false;
+	uint32 seed = 0;
+	uint64 steps = 0;
+
+	// Current run: recording extends it until the input changes,
+	// playback hands it out until it is used up
+	PlayerInput runInput = 0;
+	uint32 runLength = 0;
+};
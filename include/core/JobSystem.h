@@ -0,0 +1,98 @@
+#pragma once
+
+#include "core/Globals.h"
+#include "core/MemoryTracker.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Upper bound on worker threads, whatever the hardware reports
+#define JOB_MAX_WORKERS 15
+
+// Jobs one queue holds - chunks that don't fit run right away on the forking thread
+#define JOB_QUEUE_CAPACITY 256
+
+// JobSystem: Work-stealing thread pool owned by Application (App->jobs)
+// Each thread has its own job queue: the owner pops newest-first, idle threads
+// steal oldest-first from the others. The thread that calls ParallelFor helps
+// run chunks until its own work is finished, so a frame never sleeps on a join.
+//
+// Only the thread that called Init and the workers themselves can fork work;
+// calls from any other thread simply run the loop inline.
+class JobSystem
+{
+public:
+	// Body of a ParallelFor - processes indices [begin, end)
+	// Only refers to the callable: ParallelFor returns after its last chunk, so the
+	// callable outlives every job and forking never copies or allocates it
+	class RangeFunc
+	{
+	public:
+		template <typename Func>
+		RangeFunc(const Func& func) : object(&func), invoke(&Invoke<Func>) {}
+
+		void operator()(int begin, int end) const { invoke(object, begin, end); }
+
+	private:
+		template <typename Func>
+		static void Invoke(const void* object, int begin, int end) { (*(const Func*)object)(begin, end); }
+
+		const void* object;
+		void (*invoke)(const void*, int, int);
+	};
+
+	JobSystem();
+	~JobSystem();
+
+	// Start worker threads (-1 = one less than the hardware threads, 0 = run everything inline)
+	bool Init(int workerCount = -1);
+	void Shutdown();
+
+	int GetWorkerCount() const { return (int)workers.size(); }
+
+	// Fork/join over [0, count) in chunks of at most grainSize indices
+	// Chunks run concurrently and in any order - body must only touch data owned by its range
+	// Returns once every chunk has finished
+	void ParallelFor(int count, int grainSize, const RangeFunc& body);
+
+private:
+	struct Job
+	{
+		const RangeFunc* body;
+		int begin;
+		int end;
+		std::atomic<int>* pending;
+		MemoryTag memoryTag;    // the forking thread's, so job allocations are charged to it
+	};
+
+	// Fixed ring of jobs, guarded by its mutex - no allocations once created
+	// The owner pushes and pops at the back, thieves take from the front
+	struct JobQueue
+	{
+		std::mutex mutex;
+		Job jobs[JOB_QUEUE_CAPACITY];
+		size_t front = 0;   // oldest job
+		size_t count = 0;
+
+		bool PushBack(const Job& job);
+		bool PopBack(Job& job);
+		bool PopFront(Job& job);
+	};
+
+	void WorkerLoop(int queueIndex);
+	bool PopOrSteal(int queueIndex, Job& job);
+	void Execute(const Job& job);
+
+	std::vector<std::thread> workers;
+
+	// queues[0] belongs to the thread that called Init, queues[i] to worker i-1
+	std::vector<JobQueue*> queues;
+
+	std::mutex wakeMutex;
+	std::condition_variable wakeCondition;
+	std::atomic<int> queuedJobs;
+	std::atomic<bool> running;
+};
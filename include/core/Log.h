@@ -0,0 +1,163 @@
+#pragma once
+
+#include "core/LogFormat.h"
+
+#include <atomic>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+// Records waiting for the writer thread - when full, new records are dropped and counted
+#define LOG_QUEUE_SIZE 4096
+
+// Bytes of encoded arguments per record, longer strings are truncated
+#define LOG_PAYLOAD_SIZE 512
+
+// Messages a single call site may print per second, the rest are counted and summarized
+// (console only - nothing is limited while a binary log is open)
+#define LOG_RATE_LIMIT 20
+
+enum LogLevel
+{
+	LOG_LEVEL_DEBUG,
+	LOG_LEVEL_INFO,
+	LOG_LEVEL_WARNING,
+	LOG_LEVEL_ERROR
+};
+
+// One per call site (a static inside the LOG macros)
+// The format string lives here, records only carry the site id and raw arguments
+struct LogSite
+{
+	const char* file;
+	int line;
+	LogLevel level;
+	const char* format;
+
+	std::atomic<uint32_t> id{ 0 };
+	std::atomic<int64_t> windowStart{ 0 };
+	std::atomic<int> windowCount{ 0 };
+	std::atomic<int> suppressed{ 0 };
+};
+
+// LOG       - general information
+// LOG_WARN  - something is off but the game carries on
+// LOG_ERR   - something failed
+// LOG_DBG   - chatty details, compiled out of Release (NDEBUG) builds
+// A call only copies its arguments into a queued binary record (no formatting);
+// a background writer turns records into console text and/or a binary log file.
+// Formats must be string literals and arguments numbers, pointers or C strings.
+#define LOG_AT(level, format, ...) do { static LogSite log_site_ = { __FILE__, __LINE__, level, format }; log(&log_site_, ##__VA_ARGS__); } while (0);
+
+#define LOG(format, ...) LOG_AT(LOG_LEVEL_INFO, format, ##__VA_ARGS__)
+#define LOG_WARN(format, ...) LOG_AT(LOG_LEVEL_WARNING, format, ##__VA_ARGS__)
+#define LOG_ERR(format, ...) LOG_AT(LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+
+#ifdef NDEBUG
+#define LOG_DBG(format, ...)
+#else
+#define LOG_DBG(format, ...) LOG_AT(LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
+#endif
+
+// Record being filled by a LOG call, see log() below
+struct LogRecord
+{
+	uint8_t* payload;
+	size_t size;
+	void* slot;
+};
+
+// Rate limit, then reserve a record for the site (false = drop this call)
+bool log_begin(LogSite* site, LogRecord& record);
+// Hand the filled record to the writer
+void log_commit(LogRecord& record);
+
+// Write every message to this binary file as well (decode it with tools/logdecode)
+// While it is open the console only shows warnings and errors
+bool log_open_binary(const char* path);
+
+// Wait until every queued message has been written
+void log_flush();
+
+// Write what is left and stop the writer thread - later messages are written directly
+void log_shutdown();
+
+// === ARGUMENT ENCODING ===
+inline void log_put(LogRecord& record, const void* data, size_t bytes)
+{
+	if (record.size + bytes > LOG_PAYLOAD_SIZE) return;
+	memcpy(record.payload + record.size, data, bytes);
+	record.size += bytes;
+}
+
+inline void log_put_tag(LogRecord& record, uint8_t tag, const void* value, size_t bytes)
+{
+	// Never store half an argument
+	if (record.size + 1 + bytes > LOG_PAYLOAD_SIZE) return;
+	log_put(record, &tag, 1);
+	log_put(record, value, bytes);
+}
+
+inline void log_put_string(LogRecord& record, const char* text)
+{
+	if (text == nullptr) text = "(null)";
+	if (record.size + 3 > LOG_PAYLOAD_SIZE) return;
+
+	size_t length = strlen(text);
+	size_t room = LOG_PAYLOAD_SIZE - record.size - 3;
+	uint16_t stored = (uint16_t)(length < room ? length : room);
+	uint8_t tag = LOG_ARG_STRING;
+
+	log_put(record, &tag, 1);
+	log_put(record, &stored, sizeof(stored));
+	log_put(record, text, stored);
+}
+
+template <typename T>
+struct LogUnsupportedArg : std::false_type {};
+
+template <typename T>
+inline void log_put_arg(LogRecord& record, T value)
+{
+	if constexpr (std::is_same<T, const char*>::value || std::is_same<T, char*>::value)
+	{
+		log_put_string(record, value);
+	}
+	else if constexpr (std::is_floating_point<T>::value)
+	{
+		double number = (double)value;
+		log_put_tag(record, LOG_ARG_DOUBLE, &number, sizeof(number));
+	}
+	else if constexpr (std::is_pointer<T>::value)
+	{
+		uint64_t address = (uint64_t)(uintptr_t)value;
+		log_put_tag(record, LOG_ARG_POINTER, &address, sizeof(address));
+	}
+	else if constexpr (std::is_enum<T>::value || (std::is_integral<T>::value && std::is_signed<T>::value))
+	{
+		int64_t number = (int64_t)value;
+		log_put_tag(record, LOG_ARG_INT, &number, sizeof(number));
+	}
+	else if constexpr (std::is_integral<T>::value)
+	{
+		uint64_t number = (uint64_t)value;
+		log_put_tag(record, LOG_ARG_UINT, &number, sizeof(number));
+	}
+	else
+	{
+		static_assert(LogUnsupportedArg<T>::value, "LOG arguments must be numbers, pointers or C strings");
+	}
+}
+
+template <typename... Args>
+void log(LogSite* site, Args... args)
+{
+	LogRecord record;
+	if (!log_begin(site, record)) return;
+
+	// Arguments in order (the initializer list guarantees left to right)
+	int expand[] = { 0, (log_put_arg(record, args), 0)... };
+	(void)expand;
+
+	log_commit(record);
+}
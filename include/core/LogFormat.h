@@ -0,0 +1,43 @@
+#pragma once
+
+// Binary log format - shared by the game's log writer and tools/logdecode
+// Everything is little-endian, as written by the host
+//
+// File:    LOG_FILE_MAGIC (8 bytes), then records back to back
+// Records: SITE        type u8, site u32, level u8, line u32, file (u16 length + bytes), format (u16 length + bytes)
+//          MESSAGE     type u8, site u32, timestamp i64 (ns since start), payload (u16 length + bytes)
+//          SUPPRESSED  type u8, site u32, timestamp i64, count u32
+//          DROPPED     type u8, count u32
+// A SITE record is written once, before the first MESSAGE that refers to it.
+// Payload: the call's arguments in order, each a LogArgType tag followed by its value
+//          (INT i64, UINT u64, DOUBLE f64, POINTER u64, STRING u16 length + bytes)
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define LOG_FILE_MAGIC "LGPLOG1"
+#define LOG_FILE_MAGIC_SIZE 8
+
+enum LogRecordType
+{
+	LOG_RECORD_SITE = 1,
+	LOG_RECORD_MESSAGE,
+	LOG_RECORD_SUPPRESSED,
+	LOG_RECORD_DROPPED
+};
+
+enum LogArgType
+{
+	LOG_ARG_INT = 1,
+	LOG_ARG_UINT,
+	LOG_ARG_DOUBLE,
+	LOG_ARG_POINTER,
+	LOG_ARG_STRING
+};
+
+// "WARNING: " style prefix for a LogLevel value ("" for info)
+const char* log_level_prefix(int level);
+
+// Expand a printf format string with arguments from a binary payload
+// Returns the number of characters written to out (always null-terminated)
+int log_format_payload(const char* format, const uint8_t* payload, size_t payloadSize, char* out, size_t outSize);
@@ -105,6 +105,8 @@ struct MapObject
     bool isClosed = true; // true for polygons (closed), false for polylines (open)
 };
 
+struct CachedTrack;
+
 struct MapData
 {
     int width;
@@ -123,26 +125,32 @@ public:
     Map(Application* app, bool start_enabled = true);
     virtual ~Map();
 
+    void DeclareAccess() override;
+
     bool Init() override;
     bool Start() override;
     update_status Update() override;
     update_status PostUpdate() override;
     bool CleanUp() override;
 
-    bool Load(const std::string& path, const std::string& mapFileName);
+    // Parse a .tmx into mapData and load its textures (Start does it through the track cache)
+    bool Load(const std::string& path, const std::string& mapFileName, MapData& mapData);
     vec2f MapToWorld(int i, int j) const;
     vec2i WorldToMap(int x, int y) const;
     TileSet* GetTilesetFromTileId(int gid) const;
     MapObject* GetObjectByName(const std::string& name) const;
     void RenderMap() const;
 
+    // The track shown right now (empty while the module is disabled)
+    const MapData& GetMapData() const;
+
 public:
     std::string mapFileName;
     std::string mapPath;
-    MapData mapData;
 
 private:
-    bool mapLoaded;
+    CachedTrack* track;
+    void BuildColliders(CachedTrack& cached) const;
     void CreateCollisionBodies();
     bool TriangulatePolygon(const std::vector<vec2i>& polygon, std::vector<std::vector<float>>& triangles);
     bool IsEar(const std::vector<vec2i>& vertices, size_t prev, size_t current, size_t next);
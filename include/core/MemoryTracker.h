@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdint.h>
+
+// Heap allocation counters per subsystem
+// Global operator new/delete are replaced (MemoryTracker.cpp) and every allocation is
+// charged to the calling thread's current tag. Application tags each module phase,
+// jobs inherit the tag of the thread that forked them, and service entry points
+// (physics bodies, resource loads, audio) set their own with a MemoryScope.
+// Only C++ allocations are seen - raylib and Box2D allocate with malloc.
+// The counters are shared by the whole process, so several Applications stepping at
+// once (racing-batch) see each other's allocations.
+// Build with MEMORY_TRACKING_DISABLED to keep the default allocator and count nothing.
+
+// Race frames after the race starts that may still allocate (first-use growth, lazy caches)
+#define MEMORY_WARMUP_FRAMES 120
+
+enum MemoryTag : uint8_t
+{
+	MEM_UNTAGGED,
+	MEM_PHYSICS,
+	MEM_MAP,
+	MEM_ENTITIES,
+	MEM_RESOURCES,
+	MEM_RENDER,
+	MEM_AUDIO,
+	MEM_TAG_COUNT
+};
+
+// Totals since startup - or, as returned by memory_diff, over an interval
+struct MemoryCounters
+{
+	uint64_t calls[MEM_TAG_COUNT] = {};     // operator new calls
+	uint64_t bytes[MEM_TAG_COUNT] = {};     // bytes requested by those calls
+	int64_t live[MEM_TAG_COUNT] = {};       // bytes allocated and not yet freed (by allocating tag)
+
+	uint64_t TotalCalls() const;
+	uint64_t TotalBytes() const;
+};
+
+// Tag charged for the calling thread's allocations, returns the previous one
+MemoryTag memory_set_tag(MemoryTag tag);
+MemoryTag memory_get_tag();
+
+// Current totals of every tag
+void memory_snapshot(MemoryCounters& counters);
+
+// Calls and bytes between two snapshots, live bytes as of 'end'
+MemoryCounters memory_diff(const MemoryCounters& start, const MemoryCounters& end);
+
+const char* memory_tag_name(MemoryTag tag);
+
+// Charges allocations in the enclosing scope to a tag, then restores the previous one
+class MemoryScope
+{
+public:
+	explicit MemoryScope(MemoryTag tag) : previous(memory_set_tag(tag)) {}
+	~MemoryScope() { memory_set_tag(previous); }
+
+	MemoryScope(const MemoryScope&) = delete;
+	MemoryScope& operator=(const MemoryScope&) = delete;
+
+private:
+	MemoryTag previous;
+};
@@ -1,14 +1,28 @@
 #pragma once
 
 #include "Globals.h"
+#include "MemoryTracker.h"
+
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
 
 class Application;
 class PhysBody;
+class StateWriter;
+class StateReader;
 
 class Module
 {
 private :
 	bool enabled;
+	const char* moduleName = "Module";
+	MemoryTag memoryTag = MEM_UNTAGGED;
+
+	// Modules touched by PreUpdate/FixedUpdate/Update, see DeclareAccess()
+	bool accessDeclared = false;
+	std::vector<const Module*> reads;
+	std::vector<const Module*> writes;
 
 public:
 	Application* App;
@@ -24,10 +38,33 @@ public:
 		return enabled;
 	}
 
+	// Display name used by the profiler and debug tools
+	const char* GetName() const
+	{
+		return moduleName;
+	}
+
+	void SetName(const char* module_name)
+	{
+		moduleName = module_name;
+	}
+
+	// Subsystem charged for this module's allocations (see MemoryTracker.h)
+	MemoryTag GetMemoryTag() const
+	{
+		return memoryTag;
+	}
+
+	void SetMemoryTag(MemoryTag tag)
+	{
+		memoryTag = tag;
+	}
+
 	void Enable()
 	{
 		if(enabled == false)
 		{
+			MemoryScope memory(memoryTag);
 			enabled = true;
 			Start();
 		}
@@ -37,11 +74,20 @@ public:
 	{
 		if(enabled == true)
 		{
+			MemoryScope memory(memoryTag);
 			enabled = false;
 			CleanUp();
 		}
 	}
 
+	// Called before Init on every module, enabled or not. Kick off work here that
+	// doesn't need the window - file reads, image decodes (ModuleResources::PreloadTexture),
+	// the audio device - so it overlaps window creation and the intro instead of
+	// stalling the Start() that needs it. Presentation modules are skipped headless.
+	virtual void Preload()
+	{
+	}
+
 	virtual bool Init() 
 	{
 		return true; 
@@ -57,6 +103,13 @@ public:
 		return UPDATE_CONTINUE;
 	}
 
+	// Simulation step - called zero or more times per frame with a fixed dt
+	// Physics, AI and car logic live here so they don't depend on the render rate
+	virtual update_status FixedUpdate(float dt)
+	{
+		return UPDATE_CONTINUE;
+	}
+
 	virtual update_status Update()
 	{
 		return UPDATE_CONTINUE;
@@ -75,4 +128,68 @@ public:
 	virtual void OnCollision(PhysBody* bodyA, PhysBody* bodyB)
 	{
 	}
+
+	// Simulation snapshot (see Application::SaveState) - modules with simulation
+	// state write it here and read it back in the same order. Bodies and entities
+	// stay alive, only their state is overwritten. Return false if the data doesn't fit.
+	virtual void SaveState(StateWriter& writer) const
+	{
+	}
+
+	virtual bool LoadState(StateReader& reader)
+	{
+		return true;
+	}
+
+	// Scheduling - called once all modules exist. Declare here (with Reads/Writes,
+	// an empty list is fine) which modules PreUpdate, FixedUpdate and Update touch,
+	// and Application may run this module concurrently with those it doesn't conflict with.
+	// A module always counts as writing itself. Modules that declare nothing are
+	// barriers: they run alone, on the main thread, in list order.
+	// Internally synchronized services (ModuleAudio::PlayFx...) need no declaration.
+	virtual void DeclareAccess()
+	{
+	}
+
+	bool IsBarrier() const
+	{
+		return !accessDeclared;
+	}
+
+	bool ConflictsWith(const Module* other) const
+	{
+		if (other->Touches(this) || Touches(other))
+			return true;
+
+		for (const Module* written : writes)
+		{
+			if (other->Touches(written)) return true;
+		}
+		for (const Module* written : other->writes)
+		{
+			if (Touches(written)) return true;
+		}
+		return false;
+	}
+
+protected:
+	void Reads(std::initializer_list<const Module*> modules)
+	{
+		accessDeclared = true;
+		reads.insert(reads.end(), modules.begin(), modules.end());
+	}
+
+	void Writes(std::initializer_list<const Module*> modules)
+	{
+		accessDeclared = true;
+		writes.insert(writes.end(), modules.begin(), modules.end());
+	}
+
+private:
+	bool Touches(const Module* module) const
+	{
+		return module == this
+			|| std::find(reads.begin(), reads.end(), module) != reads.end()
+			|| std::find(writes.begin(), writes.end(), module) != writes.end();
+	}
 };
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "core/Globals.h"
+#include <vector>
+
+// Number of frames kept per sample (~4 seconds at 60 FPS)
+#define PROFILER_HISTORY 240
+
+// Stats are recomputed every N frames so the overlay stays readable
+#define PROFILER_REFRESH_FRAMES 15
+
+// Module update phases timed by Application::Update
+enum ProfilePhase
+{
+	PHASE_PRE_UPDATE,
+	PHASE_FIXED_UPDATE,
+	PHASE_UPDATE,
+	PHASE_POST_UPDATE,
+	PHASE_COUNT
+};
+
+// Rolling statistics over the last PROFILER_HISTORY frames (milliseconds)
+struct ProfileStats
+{
+	float minMs = 0.0f;
+	float avgMs = 0.0f;
+	float p99Ms = 0.0f;
+	float maxMs = 0.0f;
+	int samples = 0;
+};
+
+// Profiler: Per-module, per-phase frame timings
+// Application records one sample per module and phase each frame
+// (FixedUpdate time is summed over all simulation steps of the frame)
+class Profiler
+{
+public:
+	Profiler();
+
+	// Register a timed slot (one per module), returns its index
+	int AddSlot(const char* name);
+
+	// Frame bracketing - samples recorded between these two calls belong to one frame
+	void BeginFrame();
+	void EndFrame(double frameMs);
+
+	// Add time spent by a slot in a phase during the current frame
+	void Record(int slot, ProfilePhase phase, double ms);
+
+	// Results
+	int GetSlotCount() const { return (int)slots.size(); }
+	const char* GetSlotName(int slot) const;
+	const ProfileStats& GetStats(int slot, ProfilePhase phase) const;
+
+	// All modules of a phase added together
+	const ProfileStats& GetPhaseStats(ProfilePhase phase) const;
+
+	// Whole frame, as measured by Application::Update
+	const ProfileStats& GetFrameStats() const { return frame.stats; }
+
+	static const char* GetPhaseName(ProfilePhase phase);
+
+private:
+	// Ring buffer of per-frame samples plus the stats computed from it
+	struct History
+	{
+		float samples[PROFILER_HISTORY];
+		int count = 0;
+		int head = 0;
+		ProfileStats stats;
+
+		void Push(float ms);
+		void ComputeStats();
+	};
+
+	struct Slot
+	{
+		const char* name;
+		History phases[PHASE_COUNT];
+		double current[PHASE_COUNT];
+		bool ran[PHASE_COUNT];
+	};
+
+	std::vector<Slot> slots;
+	History phaseTotals[PHASE_COUNT];
+	History frame;
+
+	int framesSinceRefresh;
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "core/Globals.h"
+#include <stdint.h>
+
+// Budget share the smoothed frame work may use before quality drops / below which it rises
+#define QUALITY_DOWNGRADE_LOAD 0.90
+#define QUALITY_UPGRADE_LOAD 0.60
+// Frames the load must stay past a threshold before the level changes
+#define QUALITY_DOWNGRADE_FRAMES 30
+#define QUALITY_UPGRADE_FRAMES 180
+// Weight of the newest frame in the smoothed work
+#define QUALITY_WORK_SMOOTHING 0.1
+
+enum QualityLevel : uint8_t
+{
+	QUALITY_LOWEST,
+	QUALITY_LOW,
+	QUALITY_MEDIUM,
+	QUALITY_HIGH,
+	QUALITY_LEVEL_COUNT
+};
+
+// Optional work, from cheapest to full
+struct QualitySettings
+{
+	// Presentation
+	int mudParticles;            // per car and frame in Car::Draw
+	int waterParticles;
+	bool backgroundTexture;      // ModuleGame's tiled background behind the map
+	bool thickDebugLines;        // debug draw outlines sensors three times
+
+	// Simulation - these change the race, so they stay at full quality whenever the
+	// race must reproduce exactly (headless runs, input recording and replay)
+	int velocityIterations;      // b2World::Step
+	int positionIterations;
+	int diagonalSensorInterval;  // NPC radar: steps between recasts of the diagonal rays
+};
+
+// QualityGovernor: Keeps frames inside their time budget by scaling optional work
+// Fed the CPU work of every race frame (input read until present, see FramePacer), it
+// drops a level once the smoothed work stays near the budget and climbs back after a
+// long stretch well below it. Asymmetric on purpose: a missed frame shows, a late upgrade doesn't.
+class QualityGovernor
+{
+public:
+	QualityGovernor();
+
+	// Fixed level (no adapting) or QUALITY_LEVEL_COUNT for adaptive
+	void SetFixedLevel(QualityLevel level);
+	bool IsAdaptive() const { return adaptive; }
+
+	// Keep the simulation settings at full quality
+	void SetSimulationLocked(bool locked);
+
+	void Update(double workMs, double budgetMs);
+
+	QualityLevel GetLevel() const { return level; }
+	const QualitySettings& GetSettings() const { return settings; }
+	double GetSmoothedWorkMs() const { return smoothedWorkMs; }
+
+	static const char* GetLevelName(QualityLevel level);
+
+private:
+	void SetLevel(QualityLevel newLevel);
+
+	QualityLevel level = QUALITY_HIGH;
+	bool adaptive = true;
+	bool simulationLocked = false;
+	QualitySettings settings;
+
+	double smoothedWorkMs = 0.0;
+	int framesOverBudget = 0;
+	int framesUnderBudget = 0;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "core/Globals.h"
+#include <stdint.h>
+
+// Systems that draw random numbers, each from its own streams (see RandomStreamId)
+enum RandomStream : uint32_t
+{
+	RANDOM_STREAM_RACE,      // race-wide simulation decisions (Application::GetRandom)
+	RANDOM_STREAM_AI,        // simulation: one per NPC, by its index in NPCManager
+	RANDOM_STREAM_EFFECTS,   // cosmetic: terrain particles, one per car
+	RANDOM_STREAM_CAMERA     // cosmetic: screen shake
+};
+
+// Stream of one system, or of one entity within it
+inline uint64_t RandomStreamId(RandomStream system, uint32_t index = 0)
+{
+	return ((uint64_t)system << 32) | index;
+}
+
+// Random: Small seeded generator (PCG32) for simulation decisions
+// Each Application owns one, so races with the same seed make the same choices
+// no matter how many other races run in the process. Not thread-safe - use it
+// from the thread that steps the simulation.
+// One seed gives many independent streams: every system and entity draws from its
+// own, so a draw in one never shifts the numbers another sees - cosmetic effects
+// can't perturb the simulation, and an NPC's choices don't depend on how many
+// NPCs came before it. Stream 0 is the plain PCG32 sequence of the seed.
+class Random
+{
+public:
+	Random(uint64_t seed = 0, uint64_t stream = 0);
+
+	void Seed(uint64_t seed, uint64_t stream = 0);
+
+	// Uniform 32 random bits
+	uint32_t Next();
+
+	// Uniform integer in [min, max] (both included, like raylib's GetRandomValue)
+	int Range(int min, int max);
+
+private:
+	uint64_t state;
+	uint64_t increment;   // odd, selects the stream
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "core/Globals.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// XXH64 of a byte range (same values as the reference xxHash, little-endian)
+uint64_t xxh64(const void* data, size_t size, uint64_t seed = 0);
+
+// StateHashLog: Per-step simulation state hashes as text, one "step hash" line each
+// Written by --hash-log, compared against by --hash-check. Being text, two logs from
+// different builds or thread counts (on the same platform and toolchain) can also be
+// diffed directly.
+class StateHashLog
+{
+public:
+	~StateHashLog();
+
+	bool OpenWrite(const char* path);
+	bool OpenCheck(const char* path);
+	void Close();
+
+	bool IsOpen() const { return file != nullptr; }
+	bool IsChecking() const { return file != nullptr && checking; }
+
+	// Write this step's hash, or compare it with the file's - false from the first mismatch on
+	bool Step(uint64 step, uint64_t hash);
+
+	bool HasDiverged() const { return diverged; }
+	uint64 GetDivergedStep() const { return divergedStep; }
+	uint64 GetCheckedSteps() const { return checkedSteps; }
+
+private:
+	FILE* file = nullptr;
+	bool checking = false;
+	bool exhausted = false;     // check file ended before the run did
+	bool diverged = false;
+	uint64 divergedStep = 0;
+	uint64 checkedSteps = 0;
+};
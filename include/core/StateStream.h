@@ -0,0 +1,114 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Flat binary streams for simulation snapshots (see Application::SaveState)
+// Values are copied as raw bytes, so a snapshot only loads into the same build
+
+// StateWriter: Appends values to a byte buffer
+// The buffer is only cleared by its owner - reusing one keeps saving allocation free
+class StateWriter
+{
+public:
+	explicit StateWriter(std::vector<uint8_t>& target) : buffer(target) {}
+
+	template <typename T>
+	void Write(const T& value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be written to a state stream");
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+		buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+	}
+
+	void WriteString(const std::string& text)
+	{
+		Write((uint32_t)text.size());
+		buffer.insert(buffer.end(), text.begin(), text.end());
+	}
+
+	// Sections are length-prefixed so a reader can skip or bound-check them
+	size_t BeginSection()
+	{
+		size_t start = buffer.size();
+		Write((uint32_t)0);
+		return start;
+	}
+
+	void EndSection(size_t start)
+	{
+		uint32_t size = (uint32_t)(buffer.size() - start - sizeof(uint32_t));
+		memcpy(buffer.data() + start, &size, sizeof(size));
+	}
+
+	size_t GetSize() const { return buffer.size(); }
+
+private:
+	std::vector<uint8_t>& buffer;
+};
+
+// StateReader: Reads values back in the order they were written
+// Reading past the end fails the reader (values are left untouched) - check IsValid()
+class StateReader
+{
+public:
+	StateReader(const uint8_t* source, size_t length) : data(source), size(length) {}
+
+	template <typename T>
+	bool Read(T& value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only plain values can be read from a state stream");
+		if (!Have(sizeof(T))) return false;
+		memcpy(&value, data + offset, sizeof(T));
+		offset += sizeof(T);
+		return true;
+	}
+
+	bool ReadString(std::string& text)
+	{
+		uint32_t length = 0;
+		if (!Read(length) || !Have(length)) return false;
+		text.assign(reinterpret_cast<const char*>(data + offset), length);
+		offset += length;
+		return true;
+	}
+
+	// Reader limited to the next section, this reader skips past it
+	StateReader ReadSection()
+	{
+		uint32_t sectionSize = 0;
+		if (!Read(sectionSize) || !Have(sectionSize))
+		{
+			StateReader empty(nullptr, 0);
+			empty.failed = true;
+			return empty;
+		}
+
+		StateReader section(data + offset, sectionSize);
+		offset += sectionSize;
+		return section;
+	}
+
+	// Every byte read and nothing failed
+	bool IsComplete() const { return !failed && offset == size; }
+	bool IsValid() const { return !failed; }
+
+private:
+	bool Have(size_t bytes)
+	{
+		if (failed || bytes > size - offset)
+		{
+			failed = true;
+			return false;
+		}
+		return true;
+	}
+
+	const uint8_t* data;
+	size_t size;
+	size_t offset = 0;
+	bool failed = false;
+};
@@ -1,8 +1,31 @@
 #pragma once
 
-#include "Globals.h"
-#include "Timer.h"
+#include <stdint.h>
+#include <atomic>
 
+// Time accumulators listed by time_accumulators_log - more still time, but aren't listed
+#define MAX_TIME_ACCUMULATORS 64
+
+// Length of the TSC calibration against the monotonic clock, paid once on first use
+#define CLOCK_TSC_CALIBRATION_MS 2.0
+
+// Monotonic high-resolution clock - needs neither raylib nor a window, usable from any thread
+// Ticks are the cheapest timestamp the platform offers: the CPU's time stamp counter on
+// Linux x86 when the kernel keeps time with it too (so it is invariant and synchronized
+// across cores), steady_clock nanoseconds everywhere else. Ticks only mean something
+// within one process, convert them before storing or printing.
+uint64_t clock_ticks();
+uint64_t clock_ticks_to_ns(uint64_t ticks);
+double clock_ticks_to_sec(uint64_t ticks);
+
+// Nanoseconds since the clock was first used
+uint64_t clock_now_ns();
+
+// "tsc" or "steady_clock", and ticks per second (calibrated for the TSC)
+const char* clock_source_name();
+double clock_ticks_per_sec();
+
+// Stopwatch, started on construction
 class Timer
 {
 public:
@@ -11,10 +34,72 @@ public:
 	Timer();
 
 	void Start();
+
+	uint64_t ReadTicks() const;
 	double ReadSec() const;
+	double ReadMs() const;
+	double ReadUs() const;
 
 private:
 
-    // Start time in seconds
-	double started_at;   
-};
\ No newline at end of file
+	uint64_t started_at;
+};
+
+// Named running total of the time spent in some scope, summed over every thread
+// Declared static (SCOPED_TIMER does it), registers itself for time_accumulators_log
+class TimeAccumulator
+{
+public:
+
+	explicit TimeAccumulator(const char* accumulatorName);
+
+	void Add(uint64_t elapsedTicks)
+	{
+		ticks.fetch_add(elapsedTicks, std::memory_order_relaxed);
+		calls.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	const char* GetName() const { return name; }
+	uint64_t GetCalls() const { return calls.load(std::memory_order_relaxed); }
+	double GetTotalMs() const { return clock_ticks_to_sec(ticks.load(std::memory_order_relaxed)) * 1000.0; }
+
+	void Reset();
+
+private:
+
+	const char* name;
+	std::atomic<uint64_t> ticks{ 0 };
+	std::atomic<uint64_t> calls{ 0 };
+};
+
+// Adds the lifetime of the scope to an accumulator
+class ScopedTimer
+{
+public:
+
+	explicit ScopedTimer(TimeAccumulator& target) : accumulator(target), started_at(clock_ticks()) {}
+	~ScopedTimer() { accumulator.Add(clock_ticks() - started_at); }
+
+	ScopedTimer(const ScopedTimer&) = delete;
+	ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+
+	TimeAccumulator& accumulator;
+	uint64_t started_at;
+};
+
+//   SCOPED_TIMER("Name")   adds the enclosing scope to the accumulator "Name"
+// Unlike TRACE_ZONE it keeps no timeline, only totals - cheap enough for hot, short calls
+#define TIMER_CONCAT_INNER(a, b) a##b
+#define TIMER_CONCAT(a, b) TIMER_CONCAT_INNER(a, b)
+#define SCOPED_TIMER(name) \
+	static TimeAccumulator TIMER_CONCAT(time_accumulator_, __LINE__)(name); \
+	ScopedTimer TIMER_CONCAT(scoped_timer_, __LINE__)(TIMER_CONCAT(time_accumulator_, __LINE__));
+
+int time_accumulator_count();
+const TimeAccumulator* time_accumulator_get(int index);
+void time_accumulators_reset();
+
+// One line per accumulator with calls, total and average time
+void time_accumulators_log();
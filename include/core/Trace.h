@@ -0,0 +1,54 @@
+#pragma once
+
+#include "core/Globals.h"
+
+// Events kept per thread, oldest overwritten first (~10 s of fully traced frames)
+#define TRACE_BUFFER_EVENTS 65536
+
+// Zones open at the same time on one thread
+#define TRACE_MAX_DEPTH 32
+
+// Length of the window written by trace_dump by default (seconds)
+#define TRACE_DUMP_SECONDS 10.0
+
+// Hot-path tracing, written as chrome://tracing / Perfetto JSON on demand
+//   TRACE_ZONE("Name")          times the enclosing scope
+//   TRACE_BEGIN("Name") ... TRACE_END()   times an explicit range on the same thread
+// Names must be string literals (or otherwise outlive the trace), only the pointer is stored
+// Build with TRACE_DISABLED to compile every zone out
+#ifndef TRACE_DISABLED
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#define TRACE_BEGIN(name) trace_begin(name, "zone");
+#define TRACE_BEGIN_CAT(name, category) trace_begin(name, category);
+#define TRACE_END() trace_end();
+#define TRACE_ZONE(name) TraceZone TRACE_CONCAT(trace_zone_, __LINE__)(name, "zone");
+#define TRACE_ZONE_CAT(name, category) TraceZone TRACE_CONCAT(trace_zone_, __LINE__)(name, category);
+
+#else
+
+#define TRACE_BEGIN(name)
+#define TRACE_BEGIN_CAT(name, category)
+#define TRACE_END()
+#define TRACE_ZONE(name)
+#define TRACE_ZONE_CAT(name, category)
+
+#endif
+
+void trace_begin(const char* name, const char* category);
+void trace_end();
+
+// Label for the calling thread in the trace viewer
+void trace_set_thread_name(const char* name);
+
+// Write the last 'seconds' of events from every thread to a JSON file
+bool trace_dump(const char* path, double seconds = TRACE_DUMP_SECONDS);
+
+// Scoped zone used by TRACE_ZONE
+struct TraceZone
+{
+	TraceZone(const char* name, const char* category) { trace_begin(name, category); }
+	~TraceZone() { trace_end(); }
+};
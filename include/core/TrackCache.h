@@ -0,0 +1,62 @@
+#pragma once
+
+#include "core/Map.h"
+#include <string>
+#include <vector>
+
+class ModuleResources;
+
+// One static collision shape of a track, in pixels, ready for ModulePhysics
+struct TrackCollider
+{
+	enum Shape
+	{
+		RECTANGLE,   // x, y = center
+		CHAIN        // vertices = x0, y0, x1, y1... in world pixels
+	};
+
+	Shape shape;
+	float x, y, width, height;
+	std::vector<float> vertices;
+	bool closed;
+	MapObject* object;   // body user data (terrain detection), nullptr for tiles of the Collisions layer
+};
+
+// A parsed track: map data with its textures loaded, plus its collision geometry
+struct CachedTrack
+{
+	std::string path;
+	std::string fileName;
+	MapData data = {};
+	std::vector<TrackCollider> colliders;
+	int users = 0;       // Maps showing it right now
+};
+
+// TrackCache: Parsed tracks kept across menu / race transitions
+// Map::Start only parses the .tmx (and loads its textures) on a miss; every later race
+// reuses the same data and only recreates the Box2D bodies, as the world itself is new.
+// Nothing is ever dropped implicitly - Evict / EvictAll free a track, its objects and its
+// texture references once no Map uses it.
+class TrackCache
+{
+public:
+	~TrackCache();
+
+	// Cached track or nullptr. Acquire / Release count the Maps using it
+	CachedTrack* Find(const std::string& path, const std::string& fileName);
+	CachedTrack* Insert(CachedTrack* track);   // takes ownership
+	void Acquire(CachedTrack* track);
+	void Release(CachedTrack* track);
+
+	// Free tracks no Map uses - false if the track is in use (or not cached)
+	bool Evict(const std::string& path, const std::string& fileName, ModuleResources* resources);
+	void EvictAll(ModuleResources* resources);
+
+	int GetTrackCount() const { return (int)tracks.size(); }
+
+	// Deletes everything a parsed MapData owns and releases its textures
+	static void FreeMapData(MapData& data, ModuleResources* resources);
+
+private:
+	std::vector<CachedTrack*> tracks;
+};
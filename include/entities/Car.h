@@ -1,10 +1,18 @@
 #pragma once
 
 #include "entities/Entity.h"
+#include "entities/CarStore.h"
 #include "raylib.h"
 #include "core/p2Point.h"
+#include "core/Random.h"
 #include <vector>
 
+class StateWriter;
+class StateReader;
+
+// Car: View over one slot of the application's CarStore
+// Tuning, terrain, transform and velocity live in the store's arrays, the Car keeps
+// what only it uses (texture, motor sound)
 class Car : public Entity
 {
 public:
@@ -20,10 +28,20 @@ public:
 	virtual ~Car();
 
 	// Lifecycle
+	// Update() is a simulation step - called from the owner's FixedUpdate()
 	bool Start() override;
 	update_status Update() override;
 	void Draw() const override;
 
+	// Slot in App->cars
+	CarId GetCarId() const { return carId; }
+
+	// Transform reads come from the store, writes go to the body and the store
+	void GetPosition(float& x, float& y) const override;
+	void SetPosition(float x, float y) override;
+	float GetRotation() const override;
+	void SetRotation(float degrees) override;
+
 	// Car controls
 	void Accelerate(float amount);
 	void Reverse(float amount);
@@ -33,17 +51,17 @@ public:
 
 	// Car properties
 	void SetMaxSpeed(float speed);
-	float GetMaxSpeed() const { return maxSpeed; }
+	float GetMaxSpeed() const;
 	float GetCurrentSpeed() const;
 
 	void SetReverseSpeed(float speed);
-	float GetReverseSpeed() const { return reverseMaxSpeed; }
+	float GetReverseSpeed() const;
 
 	void SetAcceleration(float accel);
-	float GetAcceleration() const { return accelerationForce; }
+	float GetAcceleration() const;
 
 	void SetSteeringSensitivity(float sensitivity);
-	float GetSteeringSensitivity() const { return steeringSensitivity; }
+	float GetSteeringSensitivity() const;
 
 	// Visual
 	void SetTexture(Texture2D tex);
@@ -53,26 +71,26 @@ public:
 	TerrainType GetCurrentTerrain() const;
 	void UpdateTerrainEffects();
 
+	// Look up the terrain under the car ahead of Update() - only reads the map, so
+	// owners can sample many cars from job threads; Update() then reuses the result
+	void SampleTerrain();
+
+	// Motor sound follows the car's speed - call once per rendered frame
+	void UpdateMotorSound();
+
+	// Snapshot of the body and terrain state (tuning values aren't included)
+	void SaveState(StateWriter& writer) const;
+	bool LoadState(StateReader& reader);
+
 private:
-	// Physics tuning parameters
-	float accelerationForce;
-	float reverseForce;
-	float brakeForce;
-	float maxSpeed;
-	float reverseMaxSpeed;
-	float steeringSensitivity;
-	float driftImpulse;
+	CarStore& store;
+	CarId carId;
 
 	// Rendering
 	Texture2D texture;
 	Color tint;
 	float renderScale;
-
-	// Terrain state
-	TerrainType currentTerrain;
-	float terrainFrictionModifier;
-	float terrainAccelerationModifier;
-	float terrainSpeedModifier;
+	mutable Random effectsRandom;   // particles only - never touches the simulation's streams
 
 	// Motor sound
 	Music motorSound;
@@ -82,7 +100,7 @@ private:
 	void ApplyFriction();
 	void ClampSpeed();
 	void ApplyDownforce();
-	void UpdateMotorSound();
+	void SetVelocity(float vx, float vy);
 	vec2f GetForwardVector() const;
 	vec2f GetRightVector() const;
 
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "core/Globals.h"
+#include "core/Random.h"
+#include <stdint.h>
+#include <vector>
+
+class Car;
+class PhysBody;
+
+// Radar rays every NPC casts, fanned around the car's front
+#define NPC_SENSOR_COUNT 5
+
+// Structure to store radar ray sensor information
+struct RaySensor {
+	float angleOffset; // Degrees relative to car front (-45, 0, 45, etc.)
+	float distance;    // Detected distance
+	bool hit;          // Whether it hit something
+};
+
+struct NPCState {
+	int targetIndex;
+	const char* stateName;  // One of npcStateNames (NPCManager.cpp) - set every step, so never a std::string
+
+	// For debug visualization
+	RaySensor sensors[NPC_SENSOR_COUNT];
+	int bestRayIndex;
+
+	// Stuck detection
+	bool stuck;
+	float stuckTimer;
+	float reverseSteerDir;
+
+	// Ability usage detection
+	float lastAbilityCheck;  // Timer to avoid checking every frame
+
+	// Inputs decided by UpdateAI, applied to the car by ApplyAIInputs
+	float steer;
+	float accel;
+	float brake;
+	bool pickEscapeDir;
+
+	// This NPC's own stream (RANDOM_STREAM_AI) - snapshots carry it, so loads replay the same picks
+	Random random;
+};
+
+typedef int CarId;
+#define INVALID_CAR_ID -1
+
+// CarStore: The hot state of every car, one contiguous array per field
+// A Car is a view - an index into these arrays plus its cold data (texture, sound).
+// Loops over one field of all cars (AI sensing, proximity checks, HUD) walk memory
+// linearly instead of chasing Car pointers into Box2D bodies.
+// Transform and velocity mirror the Box2D bodies, which stay the simulation's owner:
+// ModulePhysics refreshes every car after the world step and Car refreshes its own
+// entry whenever it changes its body directly (teleports, velocity changes, snapshots).
+// Ids are stable while a car lives, freed slots are reused by the next car.
+class CarStore
+{
+public:
+	CarStore();
+	~CarStore();
+
+	CarId Create(Car* car);
+	void Destroy(CarId id);
+
+	bool IsAlive(CarId id) const { return id >= 0 && id < (int)owner.size() && owner[id] != nullptr; }
+	int GetCapacity() const { return (int)owner.size(); }
+
+	// Mirror transform and velocity from the bodies - all cars, or one
+	void SyncFromBodies();
+	void SyncFromBody(CarId id);
+
+	// Components, indexed by CarId
+	std::vector<Car*> owner;            // nullptr marks a free slot
+	std::vector<PhysBody*> body;
+
+	// Transform (pixels, degrees) and velocity (pixels/s)
+	std::vector<float> posX, posY, rotation;
+	std::vector<float> velX, velY;
+
+	// Terrain modifiers (terrain values are Car::TerrainType)
+	std::vector<uint8_t> terrain;
+	std::vector<uint8_t> sampledTerrain;
+	std::vector<uint8_t> terrainSampled;
+	std::vector<float> frictionModifier;
+	std::vector<float> accelerationModifier;
+	std::vector<float> speedModifier;
+
+	// Tuning parameters
+	std::vector<float> accelerationForce;
+	std::vector<float> reverseForce;
+	std::vector<float> brakeForce;
+	std::vector<float> maxSpeed;
+	std::vector<float> reverseMaxSpeed;
+	std::vector<float> steeringSensitivity;
+	std::vector<float> driftImpulse;
+
+	// AI state - only used by NPC cars, hasAI is set once NPCManager initializes it
+	std::vector<NPCState> ai;
+	std::vector<uint8_t> hasAI;
+
+private:
+	std::vector<CarId> freeSlots;
+};
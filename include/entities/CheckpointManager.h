@@ -29,6 +29,20 @@ struct Checkpoint
 	bool crossed;           // Has the player crossed this checkpoint?
 };
 
+// Lap progress of one car - tracked for every car in the race (results, racing-batch)
+// The player's HUD state (currentLap, crossed flags...) is kept separately below
+struct CarProgress
+{
+	PhysBody* body;
+	std::string name;
+	int lap;                        // Current lap, starting at 1
+	int nextCheckpoint;             // Order of the next checkpoint, 0 = finish line
+	uint64 lapStartStep;            // Simulation step the current lap started on
+	std::vector<uint64> lapSteps;   // Completed laps, in simulation steps
+	int place;                      // Finishing position, 0 = still racing
+	uint64 finishStep;
+};
+
 // CheckpointManager: Manages race checkpoints and lap completion
 class CheckpointManager : public Module, public PhysBody::CollisionListener
 {
@@ -36,11 +50,17 @@ public:
 	CheckpointManager(Application* app, bool start_enabled = true);
 	~CheckpointManager();
 
+	void DeclareAccess() override;
+
 	bool Start() override;
+	update_status FixedUpdate(float dt) override;
 	update_status Update() override;
 	update_status PostUpdate() override;
 	bool CleanUp() override;
 
+	void SaveState(StateWriter& writer) const override;
+	bool LoadState(StateReader& reader) override;
+
 	// Collision callbacks
 	void OnCollisionEnter(PhysBody* other) override;
 	void OnCollisionExit(PhysBody* other) override;
@@ -55,6 +75,10 @@ public:
 	int GetCrossedCheckpointsCount() const;
 	bool GetCheckpointPosition(int order, float& x, float& y) const;
 
+	// Every car's laps and finishing position
+	const std::vector<CarProgress>& GetCarProgress() const { return carProgress; }
+	bool AllCarsFinished() const { return !carProgress.empty() && finishedCars == (int)carProgress.size(); }
+
 	// Race state
 	RaceState GetRaceState() const { return raceState; }
 	bool CanPlayerMove() const { return raceState == RACE_RUNNING; }
@@ -93,6 +117,10 @@ private:
 	// Player reference
 	PhysBody* playerBody;
 
+	// Per-car progress, in the order cars were registered (player first)
+	std::vector<CarProgress> carProgress;
+	int finishedCars;
+
 	// Sound effects
 	unsigned int lapCompleteSfxId;
 	unsigned int countdownBeepSfxId;
@@ -106,9 +134,14 @@ private:
 	void LoadCheckpointsFromMap();
 	void CreateCheckpointSensor(MapObject* object, int order);
 	Checkpoint* FindCheckpointBySensor(PhysBody* sensor);
+	Checkpoint* FindNearestCheckpoint(PhysBody* car);
+	void RegisterCars();
+	void StartRaceClock();
+	void AdvanceCarProgress(CarProgress& progress, int checkpointOrder);
 	bool ValidateCheckpointSequence(int checkpointOrder);
 	void ResetCheckpoints();
-	void UpdateGetReady();
-	void UpdateIntro();
-	void UpdateCountdown();
+	void UpdateGetReady(float dt);
+	void UpdateIntro(float dt);
+	void UpdateCountdown(float dt);
+	void UpdatePreRaceCamera();
 };
\ No newline at end of file
@@ -22,10 +22,14 @@ public:
 	void SetPhysBody(PhysBody* body) { physBody = body; }
 
 	// Position/rotation helpers (delegates to physics body)
-	void GetPosition(float& x, float& y) const;
-	void SetPosition(float x, float y);
-	float GetRotation() const;
-	void SetRotation(float degrees);
+	virtual void GetPosition(float& x, float& y) const;
+	virtual void SetPosition(float x, float y);
+	virtual float GetRotation() const;
+	virtual void SetRotation(float degrees);
+
+	// Interpolated transform for drawing - smooth between fixed simulation steps
+	void GetRenderPosition(float& x, float& y) const;
+	float GetRenderRotation() const;
 
 	// Active state
 	void SetActive(bool active);
@@ -2,6 +2,7 @@
 
 #include "core/Module.h"
 #include "core/Globals.h"
+#include <string>
 #include <vector>
 
 class Car;
@@ -13,11 +14,17 @@ public:
 	NPCManager(Application* app, bool start_enabled = true);
 	virtual ~NPCManager();
 
+	void DeclareAccess() override;
+
 	bool Start() override;
+	update_status FixedUpdate(float dt) override;
 	update_status Update() override;
 	update_status PostUpdate() override;
 	bool CleanUp() override;
 
+	void SaveState(StateWriter& writer) const override;
+	bool LoadState(StateReader& reader) override;
+
 	// Access to NPC cars
 	const std::vector<Car*>& GetNPCs() const { return npcCars; }
 	Car* GetNPC(int index) const;
@@ -27,6 +34,11 @@ private:
 	std::vector<PushAbility*> npcAbilities;
 
 	void CreateNPC(const char* npcName, const char* texturePath);
-	void UpdateAI(Car* npc);
-	void CheckAndUseAbility(Car* npc, PushAbility* ability);
+	// AI state lives in App->cars next to the rest of the car's hot data
+	void InitAIState(Car* npc, int index);
+	// Sensing and decisions - safe to run for different NPCs on job threads
+	void UpdateAI(Car* npc, float dt);
+	// Feeds the decided inputs to the car - main thread only
+	void ApplyAIInputs(Car* npc);
+	void CheckAndUseAbility(Car* npc, PushAbility* ability, float dt);
 };
\ No newline at end of file
@@ -3,6 +3,8 @@
 // Forward declarations - NEVER include box2d.h in this header
 class b2Body;
 class b2Fixture;
+class StateWriter;
+class StateReader;
 
 // PhysBody: Wrapper class for Box2D physics bodies
 // This class provides a clean interface to Box2D physics without exposing Box2D types
@@ -27,6 +29,16 @@ public:
 	// Set rotation in degrees
 	void SetRotation(float degrees);
 
+	// Render transform blended between the previous and current simulation step
+	// alpha: 0 = previous step, 1 = current step (see Application::GetInterpolationAlpha)
+	void GetInterpolatedPositionF(float alpha, float& x, float& y) const;
+	float GetInterpolatedRotation(float alpha) const;
+
+	// Snapshot of the simulated state: transform, velocities, sleep state and the
+	// previous transform used for interpolation. Shape and fixtures are not included.
+	void SaveState(StateWriter& writer) const;
+	bool LoadState(StateReader& reader);
+
 	// Velocity stuff
 	// Get linear velocity in pixels/second
 	void GetLinearVelocity(float& vx, float& vy) const;
@@ -146,5 +158,9 @@ private:
 	void* userData;
 	CollisionListener* collisionListener;
 
+	// Transform at the start of the last simulation step (pixels / degrees)
+	float prevX, prevY, prevRotation;
+	void SavePreviousTransform();
+
 	b2Fixture* GetMainFixture() const;
 };
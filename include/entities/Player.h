@@ -2,6 +2,7 @@
 #include "core/Module.h"
 #include "core/Globals.h"
 #include "core/p2Point.h"
+#include "core/InputRecorder.h"
 #include "raylib.h"
 
 class Car;
@@ -13,11 +14,17 @@ public:
 	ModulePlayer(Application* app, bool start_enabled = true);
 	virtual ~ModulePlayer();
 
+	void DeclareAccess() override;
+
 	bool Start();
+	update_status FixedUpdate(float dt);
 	update_status Update();
 	update_status PostUpdate();
 	bool CleanUp();
 
+	void SaveState(StateWriter& writer) const override;
+	bool LoadState(StateReader& reader) override;
+
 	// Access to player car
 	Car* GetCar() const { return playerCar; }
 
@@ -30,6 +37,15 @@ private:
 
 	unsigned int carPassingSfxId;
 
+	// Push key latched per frame, consumed by the next simulation step
+	bool pushRequested;
+
+	// An NPC was close enough to play the passing sound last frame
+	bool wasNPCNearby;
+
+	// One simulation step of input: from the keyboard or a replay, recorded if asked
 	void HandleInput();
+	PlayerInput SampleInput();
+	void ApplyInput(PlayerInput input);
 	void CheckNPCPassing();
 };
\ No newline at end of file
@@ -6,6 +6,8 @@
 
 class PhysBody;
 class Car;
+class StateWriter;
+class StateReader;
 
 // PushAbility: Special ability that creates a circular area that pushes away enemy cars
 class PushAbility
@@ -20,8 +22,8 @@ public:
 	// Activate the ability at the player's position with player's rotation
 	void Activate(float playerX, float playerY, float playerRotation, Car* activatingCar = nullptr);
 
-	// Update ability (handles animation, duration, effects)
-	void Update();
+	// Update ability (handles animation, duration, effects) - one simulation step of dt seconds
+	void Update(float dt);
 
 	// Draw the ability effect
 	void Draw() const;
@@ -35,6 +37,11 @@ public:
 	// Get cooldown progress (0.0 to 1.0)
 	float GetCooldownProgress() const;
 
+	// Snapshot of timers and the active effect - owner is the car using this ability
+	// The push sensor is created or removed to match the restored state
+	void SaveState(StateWriter& writer) const;
+	bool LoadState(StateReader& reader, Car* owner);
+
 private:
 	Application* app;
 
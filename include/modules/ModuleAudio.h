@@ -2,6 +2,9 @@
 
 #include "core/Module.h"
 
+#include <mutex>
+#include <thread>
+
 #define MAX_SOUNDS	16
 #define DEFAULT_MUSIC_FADE_TIME 2.0f
 
@@ -12,6 +15,10 @@ public:
 	ModuleAudio(Application* app, bool start_enabled = true);
 	~ModuleAudio();
 
+	void DeclareAccess() override;
+
+	// Opens the audio device on a thread of its own, see WaitForDevice
+	void Preload() override;
 	bool Init();
 	update_status Update();
 	bool CleanUp();
@@ -25,8 +32,23 @@ public:
 	// Play a previously loaded sound
 	bool PlayFx(unsigned int fx, int repeat = 0);
 
+	// Blocks until the device opened in the background is ready - false if it failed
+	// Anything that loads or plays audio goes through here first
+	bool WaitForDevice();
+
 private:
 
+	void OpenDevice();
+
+	// Device opening runs on deviceThread, deviceReady is only read after joining it
+	std::mutex deviceMutex;
+	std::thread deviceThread;
+	bool deviceStarted = false;
+	bool deviceReady = false;
+
+	// Modules running on job threads may play sounds while Update feeds the music stream
+	std::mutex streamMutex;
+
 	Music music;
 	Sound fx[MAX_SOUNDS];
 	unsigned int fx_count;
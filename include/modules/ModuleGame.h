@@ -34,6 +34,9 @@ public:
 	ModuleGame(Application* app, bool start_enabled = true);
 	~ModuleGame();
 
+	void DeclareAccess() override;
+
+	void Preload() override;
 	bool Start() override;
 	update_status Update() override;
 	update_status PostUpdate() override;
@@ -61,6 +64,16 @@ private:
 	Texture2D speedometerTexture;
 	Texture2D speedometerNeedleTexture;
 	Texture2D lapCounterTexture;
+
+	// Lap counter label - formatted and measured again only when the lap changes
+	struct LapLabel
+	{
+		int lap = -1;
+		int totalLaps = -1;
+		char text[16] = {};
+		int width = 0;
+	};
+	mutable LapLabel lapLabel;
 	
 	// Helper method to load game textures
 	void LoadGameTextures();
@@ -9,11 +9,15 @@ public:
     ModuleIntro(Application* app, bool start_enabled = true);
     ~ModuleIntro();
 
+    void Preload() override;
     bool Start() override;
     update_status Update() override;
     update_status PostUpdate() override;
     bool CleanUp() override;
 
+    // Holding the logo - nothing moves, the frame pacer may slow down
+    bool IsIdle() const;
+
 private:
     enum class IntroPhase {
         CompanyLogo,
@@ -9,11 +9,15 @@ public:
     ModuleMainMenu(Application* app, bool start_enabled = true);
     ~ModuleMainMenu();
 
+    void Preload() override;
     bool Start() override;
     update_status Update() override;
     update_status PostUpdate() override;
     bool CleanUp() override;
 
+    // Nothing has changed on screen for a while - the frame pacer may slow down
+    bool IsIdle() const;
+
 private:
     enum MenuOption {
         START,
@@ -41,7 +45,15 @@ private:
     // Menu sound effects
     unsigned int selectSfx = 0;
 
+    // The composed menu screen, redrawn only when the screen or the selection changes
+    RenderTexture2D menuFrame = {};
+    bool menuFrameValid = false;
+    MenuState drawnState = STATE_MAIN;
+    MenuOption drawnSelection = START;
+    float idleTime = 0.0f;
+
     // Helper functions for sub-menus
+    void DrawMenuScreen();
     void DrawMainMenu();
     void DrawOptionsMenu();
     void DrawCreditsMenu();
@@ -31,6 +31,7 @@ public:
 	bool Init();
 	bool Start();
 	update_status PreUpdate();
+	update_status FixedUpdate(float dt);
 	update_status PostUpdate();
 	bool CleanUp();
 
@@ -114,6 +115,10 @@ public:
 	// Get number of active collisions for debug display
 	int GetActiveCollisionCount() const { return (int)activeCollisions.size(); }
 private:
+	// Frame profiler and heap allocation panels, drawn as part of the debug overlay
+	void RenderProfiler();
+	void RenderMemory();
+
 	// Box2D world
 	b2World* world;
 	
@@ -1,6 +1,7 @@
 #pragma once
 #include "core/Module.h"
 #include "core/Globals.h"
+#include "core/Random.h"
 
 #include <limits.h>
 
@@ -43,5 +44,6 @@ public:
 
 	// Screen shake for game feel
 	float screenShakeAmount;
+	Random shakeRandom;   // cosmetic stream, apart from the simulation's
 	void AddScreenShake(float amount);
 };
\ No newline at end of file
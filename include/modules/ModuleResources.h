@@ -3,6 +3,7 @@
 #include "core/Module.h"
 #include "core/Globals.h"
 #include "raylib.h"
+#include <future>
 #include <map>
 #include <string>
 
@@ -12,11 +13,17 @@ public:
 	ModuleResources(Application* app, bool start_enabled = true);
 	~ModuleResources();
 
+	void DeclareAccess() override;
+
 	bool Init();
 	bool CleanUp();
 
 	// Texture resource management
 	Texture2D LoadTexture(const char* path);
+
+	// Decode an image file on a background thread; a later LoadTexture of the same
+	// path then only uploads it. Doesn't need the window - call it from Preload()
+	void PreloadTexture(const char* path);
 	void UnloadTexture(const char* path);
 	bool IsTextureLoaded(const char* path) const;
 
@@ -51,6 +58,9 @@ private:
 	std::map<std::string, int> textureRefCount;
 	std::map<std::string, int> soundRefCount;
 
+	// Images still decoding (or decoded but not uploaded yet), main thread only
+	std::map<std::string, std::future<Image>> pendingImages;
+
 	// Helper methods
 	std::string NormalizePath(const char* path) const;
 };
@@ -13,35 +13,67 @@
 #include "modules/ModuleIntro.h"
 
 #include "core/Application.h"
+#include "core/Trace.h"
+#include "core/JobSystem.h"
+#include "entities/CarStore.h"
+#include "core/EventBus.h"
+#include "core/TrackCache.h"
+#include "core/StateStream.h"
 
-Application::Application()
+#include <math.h>
+#include <time.h>
+#include <string>
+
+// Most modules a schedule segment can hold
+#define MAX_SCHEDULE_NODES 32
+
+// Snapshot header - bump the version whenever a module's SaveState layout changes
+#define STATE_MAGIC 0x5347504Cu   // "LPGS"
+#define STATE_VERSION 5
+
+Application::Application(const AppConfig& appConfig) : config(appConfig)
 {
-	window = new ModuleWindow(this);
+	jobs = new JobSystem();
+	cars = new CarStore();
+	events = new EventBus();
+	tracks = new TrackCache();
+
+	// Headless runs never enable the presentation modules (no window, audio or intro)
+	bool presentation = !config.headless;
+
+	window = new ModuleWindow(this, presentation);
 	resources = new ModuleResources(this, true);
 	map = new Map(this, true);
 	scene_intro = new ModuleGame(this);
-	audio = new ModuleAudio(this, true);
+	audio = new ModuleAudio(this, presentation);
 	physics = new ModulePhysics(this);
 	player = new ModulePlayer(this);
 	npcManager = new NPCManager(this);
 	checkpointManager = new CheckpointManager(this);
 	mainMenu = new ModuleMainMenu(this);
-	intro = new ModuleIntro(this);
-	renderer = new ModuleRender(this);
+	intro = new ModuleIntro(this, presentation);
+	renderer = new ModuleRender(this, presentation);
 
 	// Module initialization order matters - resources first, rendering last
-	AddModule(window);
-	AddModule(resources);  // Load resources early
-	AddModule(scene_intro); // Game scene (background)
-	AddModule(audio);
-	AddModule(map);
-	AddModule(player);     // Player car
-	AddModule(npcManager); // NPC cars after player
-	AddModule(checkpointManager);
-	AddModule(intro);      // Intro screen
-	AddModule(mainMenu);
-	AddModule(physics);    // Physics debug render - on top of car
-	AddModule(renderer);
+	AddModule(window, "Window", MEM_RENDER);
+	AddModule(resources, "Resources", MEM_RESOURCES);  // Load resources early
+	AddModule(scene_intro, "Game", MEM_RENDER); // Game scene (background)
+	AddModule(audio, "Audio", MEM_AUDIO);
+	AddModule(map, "Map", MEM_MAP);
+	AddModule(player, "Player", MEM_ENTITIES);     // Player car
+	AddModule(npcManager, "NPCManager", MEM_ENTITIES); // NPC cars after player
+	AddModule(checkpointManager, "Checkpoints", MEM_ENTITIES);
+	AddModule(intro, "Intro", MEM_RENDER);      // Intro screen
+	AddModule(mainMenu, "MainMenu", MEM_RENDER);
+	AddModule(physics, "Physics", MEM_PHYSICS);    // Physics debug render - on top of car
+	AddModule(renderer, "Render", MEM_RENDER);
+
+	// Every module exists now, so they can say which others they touch
+	for (Module* module : list_modules)
+	{
+		module->DeclareAccess();
+	}
+	BuildSchedule();
 
 	// Disable game modules initially, enable them from menu
 	scene_intro->Disable();
@@ -61,16 +93,65 @@ Application::~Application()
 		delete item;
 	}
 	list_modules.clear();
+
+	delete tracks;
+	delete events;
+	delete cars;
+	delete jobs;
 }
 
 bool Application::Init()
 {
-	bool ret = true;
+	bool ret = jobs->Init(config.workerThreads);
+
+	// Background loading starts before the window opens, so the audio device and
+	// image decodes run alongside window creation and the intro
+	for (Module* module : list_modules)
+	{
+		if (config.headless && IsPresentationModule(module)) continue;
+		MemoryScope memory(module->GetMemoryTag());
+		module->Preload();
+	}
+
+	// A replay brings its own seed, anything else uses the configured one or the clock
+	random_seed = (config.randomSeed != 0) ? config.randomSeed : (uint32)time(nullptr);
+	if (config.replayPath != nullptr)
+	{
+		ret = ret && input_recorder.StartPlayback(config.replayPath);
+		random_seed = input_recorder.GetSeed();
+	}
+	else if (config.recordPath != nullptr)
+	{
+		ret = ret && input_recorder.StartRecording(config.recordPath, random_seed);
+	}
+
+	if (config.hashCheckPath != nullptr)
+	{
+		ret = ret && hash_log.OpenCheck(config.hashCheckPath);
+	}
+	else if (config.hashLogPath != nullptr)
+	{
+		ret = ret && hash_log.OpenWrite(config.hashLogPath);
+	}
+	state_hash_enabled = config.stateHash || hash_log.IsOpen();
+
+	// Headless runs always do the full work. Recorded and replayed races may still drop
+	// presentation work, but keep the simulation settings so the race reproduces exactly
+	quality_governor.SetFixedLevel(config.headless ? QUALITY_HIGH : config.quality);
+	quality_governor.SetSimulationLocked(config.headless || input_recorder.IsRecording() || input_recorder.IsPlaying());
+
+	// Headless already runs flat out, one step per Update
+	if (!config.headless)
+	{
+		SetTimeScale(config.timeScale);
+	}
 
 	// Call Init() in all modules
 	for (auto it = list_modules.begin(); it != list_modules.end() && ret; ++it)
 	{
 		Module* module = *it;
+		if (config.headless && IsPresentationModule(module)) continue;
+		MemoryScope memory(module->GetMemoryTag());
 		ret = module->Init();
 	}
 
@@ -84,106 +165,728 @@ bool Application::Init()
 		// Disabled modules will have Start() called when Enable() is invoked
 		if (module->IsEnabled())
 		{
+			MemoryScope memory(module->GetMemoryTag());
 			ret = module->Start();
 		}
 	}
 
+	if (ret && config.headless)
+	{
+		LOG("Headless mode - simulating race for up to %llu steps", (unsigned long long)(config.maxSteps > 0 ? config.maxSteps : HEADLESS_DEFAULT_STEPS));
+		StartRace();
+		headless_time.Start();
+	}
+
+	// Loading time doesn't count as the first frame
+	frame_time.Start();
+
 	return ret;
 }
 
+void Application::StartRace()
+{
+	race_start_time.Start();
+	race_start_pending = true;
+
+	state = GAME_PLAYING;
+
+	// Same seed, same race - replays and batch runs depend on it
+	random.Seed(random_seed, RandomStreamId(RANDOM_STREAM_RACE));
+	LOG("Race random seed: %u", random_seed);
+
+	// CRITICAL: Enable in correct order!
+	// 1. Map FIRST - loads positions and collision data
+	map->Enable();
+
+	// 2. Physics SECOND - creates world for bodies
+	physics->Enable();
+
+	// 3. Game scene
+	scene_intro->Enable();
+
+	// 4. Player and NPCs - need map positions!
+	player->Enable();
+	npcManager->Enable();
+
+	// 5. Checkpoint manager - needs player reference
+	checkpointManager->Enable();
+
+	// Everything is in its starting place - keep it for RestartRace
+	state_hash = 0;
+	SaveState(race_start_state);
+}
+
+void Application::ReturnToMenu()
+{
+	if (state != GAME_PLAYING)
+		return;
+
+	if (input_recorder.IsRecording() || input_recorder.IsPlaying())
+	{
+		LOG_WARN("Return to menu ignored - input is being recorded or replayed");
+		return;
+	}
+
+	Timer timer;
+
+	// Reverse of StartRace: entities while the world still exists, the map last
+	checkpointManager->Disable();
+	npcManager->Disable();
+	player->Disable();
+	scene_intro->Disable();
+	physics->Disable();
+	map->Disable();
+
+	// Both snapshots point into the race that just went away
+	quick_save.clear();
+	race_start_state.clear();
+	fixed_accumulator = 0.0f;
+	interpolation_alpha = 1.0f;
+
+	state = GAME_MENU;
+	mainMenu->Enable();
+
+	LOG("Back to the menu in %.3f ms (%d tracks cached)", timer.ReadMs(), tracks->GetTrackCount());
+}
+
+void Application::SetTimeScale(int scale)
+{
+	if (scale < 1) scale = 1;
+	if (scale > MAX_TIME_SCALE) scale = MAX_TIME_SCALE;
+	if (scale == time_scale)
+		return;
+
+	time_scale = scale;
+	LOG("Time scale: %dx", time_scale);
+}
+
+bool Application::RestartRace()
+{
+	if (state != GAME_PLAYING || race_start_state.empty())
+		return false;
+
+	if (input_recorder.IsRecording() || input_recorder.IsPlaying())
+	{
+		LOG_WARN("Race restart ignored - input is being recorded or replayed");
+		return false;
+	}
+
+	Timer timer;
+
+	// Contacts, shakes and sounds still queued belong to the abandoned race
+	events->Clear();
+
+	if (!LoadState(race_start_state))
+		return false;
+
+	interpolation_alpha = 1.0f;
+
+	LOG("Race restarted in %.3f ms", timer.ReadMs());
+	return true;
+}
+
 // Call PreUpdate, Update and PostUpdate on all modules
 update_status Application::Update()
 {
+	TRACE_ZONE_CAT("Frame", "frame");
+
+	// Sleeps (if the pacing mode says so) and reads this frame's input
+	if (!config.headless) frame_pacer.BeginFrame();
+
+	profiler.BeginFrame();
+	events->BeginFrame();
+	memory_snapshot(memory_frame_start);
+
+	// frame_time still runs from the start of the previous frame
+	frame_delta = config.headless ? FIXED_TIMESTEP : (float)frame_time.ReadSec();
+	if (frame_delta > MAX_FRAME_TIME) frame_delta = MAX_FRAME_TIME;
+	frame_time.Start();
+
+	// The menu frame that calls StartRace doesn't count as a race frame
+	bool raceFrame = (state == GAME_PLAYING);
+
 	update_status ret = UPDATE_CONTINUE;
 
-	if (state == GAME_INTRO)
+	if (config.headless)
+	{
+		ret = UpdateHeadless();
+	}
+	else if (state == GAME_INTRO)
 	{
 		// Only update intro and renderer
-		ret = renderer->PreUpdate();
+		ret = RunPhase(renderer, PHASE_PRE_UPDATE);
 		if (ret == UPDATE_CONTINUE)
 		{
-			ret = intro->Update();
+			ret = RunPhase(intro, PHASE_UPDATE);
 		}
 		if (ret == UPDATE_CONTINUE)
 		{
-			ret = intro->PostUpdate();
+			ret = RunPhase(intro, PHASE_POST_UPDATE);
 		}
 		if (ret == UPDATE_CONTINUE)
 		{
-			ret = renderer->PostUpdate();
+			ret = RunPhase(renderer, PHASE_POST_UPDATE);
 		}
 	}
 	else if (state == GAME_MENU)
 	{
 		// Update audio for music playback
-		ret = audio->Update();
+		ret = RunPhase(audio, PHASE_UPDATE);
 		
 		// Only update menu and renderer for drawing
 		if (ret == UPDATE_CONTINUE)
 		{
-			ret = renderer->PreUpdate();
+			ret = RunPhase(renderer, PHASE_PRE_UPDATE);
 		}
 		if (ret == UPDATE_CONTINUE)
 		{
-			ret = mainMenu->Update();
+			ret = RunPhase(mainMenu, PHASE_UPDATE);
 		}
 		if (ret == UPDATE_CONTINUE)
 		{
-			ret = mainMenu->PostUpdate();
+			ret = RunPhase(mainMenu, PHASE_POST_UPDATE);
 		}
 		if (ret == UPDATE_CONTINUE)
 		{
-			ret = renderer->PostUpdate();
+			ret = RunPhase(renderer, PHASE_POST_UPDATE);
 		}
 	}
 	else
 	{
-		for (auto it = list_modules.begin(); it != list_modules.end() && ret == UPDATE_CONTINUE; ++it)
+		ret = RunPhaseOnModules(PHASE_PRE_UPDATE);
+
+		// Run the simulation in fixed steps, as many as the elapsed time requires
+		// The frame delta is clamped, so long frames (loading, window drag) don't make us catch up forever
+		// Fast-forward feeds it time_scale times the frame delta and allows as many more steps
+		fixed_accumulator += frame_delta * time_scale;
+
+		int steps = 0;
+		int maxSteps = MAX_FIXED_STEPS * time_scale;
+		while (fixed_accumulator >= FIXED_TIMESTEP && steps < maxSteps && ret == UPDATE_CONTINUE)
+		{
+			TRACE_ZONE_CAT("FixedStep", "frame");
+			ret = RunPhaseOnModules(PHASE_FIXED_UPDATE);
+			fixed_accumulator -= FIXED_TIMESTEP;
+			simulation_steps++;
+			steps++;
+			if (!UpdateStateHash()) ret = UPDATE_ERROR;
+		}
+
+		// Too far behind - drop the backlog instead of spiralling
+		if (fixed_accumulator >= FIXED_TIMESTEP)
+		{
+			fixed_accumulator = fmodf(fixed_accumulator, FIXED_TIMESTEP);
+		}
+		interpolation_alpha = fixed_accumulator / FIXED_TIMESTEP;
+
+		if (ret == UPDATE_CONTINUE)
+		{
+			ret = RunPhaseOnModules(PHASE_UPDATE);
+		}
+
+		// Shakes and sounds from this frame's steps and updates, before anything draws
+		events->DispatchFrameEvents(renderer, audio);
+
+		if (ret == UPDATE_CONTINUE)
+		{
+			ret = RunPhaseOnModules(PHASE_POST_UPDATE);
+		}
+	}
+
+	if (!config.headless && WindowShouldClose()) ret = UPDATE_STOP;
+
+	// Menu screens that show nothing new drop to the idle frame rate until they change
+	if (!config.headless)
+	{
+		bool idle = (state == GAME_MENU && mainMenu->IsEnabled() && mainMenu->IsIdle()) ||
+			(state == GAME_INTRO && intro->IsEnabled() && intro->IsIdle());
+		frame_pacer.SetIdle(idle);
+	}
+
+	// F2: dump the recent frame timeline for chrome://tracing or ui.perfetto.dev
+	if (IsKeyPressed(KEY_F2))
+	{
+		trace_dump(TextFormat("trace_%llu.json", (unsigned long long)frame_count));
+	}
+
+	// F3: next frame pacing mode
+	if (IsKeyPressed(KEY_F3))
+	{
+		frame_pacer.NextMode();
+	}
+
+	// F6: fast-forward 1x, 2x, 4x ... MAX_TIME_SCALE, then back to 1x
+	if (IsKeyPressed(KEY_F6))
+	{
+		SetTimeScale(time_scale >= MAX_TIME_SCALE ? 1 : time_scale * 2);
+	}
+
+	if (!config.headless && state == GAME_PLAYING && ret == UPDATE_CONTINUE)
+	{
+		HandleQuickSave();
+
+		// R: back to the starting grid, Escape: back to the menu
+		if (IsKeyPressed(KEY_R)) RestartRace();
+		else if (IsKeyPressed(KEY_ESCAPE)) ReturnToMenu();
+	}
+
+	FinishFrame(raceFrame);
+
+	return ret;
+}
+
+// One simulation step per call, no rendering, audio or window polling
+update_status Application::UpdateHeadless()
+{
+	update_status ret = RunPhaseOnModules(PHASE_PRE_UPDATE);
+
+	if (ret == UPDATE_CONTINUE)
+	{
+		ret = RunPhaseOnModules(PHASE_FIXED_UPDATE);
+		simulation_steps++;
+		if (!UpdateStateHash()) ret = UPDATE_ERROR;
+	}
+	if (ret == UPDATE_CONTINUE)
+	{
+		ret = RunPhaseOnModules(PHASE_UPDATE);
+	}
+	events->DispatchFrameEvents(renderer, audio);
+
+	uint64 maxSteps = (config.maxSteps > 0) ? config.maxSteps : HEADLESS_DEFAULT_STEPS;
+	bool finished = checkpointManager->IsRaceFinished();
+	bool replayDone = input_recorder.IsPlaying() && input_recorder.IsFinished();
+	if (IsAIOnly()) finished = checkpointManager->AllCarsFinished();
+	if (ret == UPDATE_CONTINUE && (finished || replayDone || simulation_steps >= maxSteps))
+	{
+		double wallSec = headless_time.ReadSec();
+		double simSec = simulation_steps * (double)FIXED_TIMESTEP;
+		LOG("Headless run %s: %llu steps (%.1fs simulated) in %.2fs wall time (%.0f steps/s, %.1fx real time)",
+			finished ? "finished race" : replayDone ? "reached end of replay" : "reached step limit",
+			(unsigned long long)simulation_steps, simSec, wallSec,
+			wallSec > 0.0 ? simulation_steps / wallSec : 0.0,
+			wallSec > 0.0 ? simSec / wallSec : 0.0);
+		if (state_hash_enabled && !IsAIOnly())
+		{
+			LOG("State hash after step %llu: %016llx", (unsigned long long)simulation_steps, (unsigned long long)state_hash);
+		}
+		LogMemoryReport();
+
+		// Scoped timers are process-wide - racing-batch reports them once for all its races
+		if (!IsAIOnly()) time_accumulators_log();
+		ret = UPDATE_STOP;
+	}
+
+	return ret;
+}
+
+bool Application::IsKeyDown(int key) const
+{
+	return !config.headless && ::IsKeyDown(key);
+}
+
+bool Application::IsKeyPressed(int key) const
+{
+	return !config.headless && ::IsKeyPressed(key);
+}
+
+// Split the module list into segments at every barrier, and inside a segment make
+// each module depend on the earlier modules it conflicts with. List order still
+// decides who sees whose writes; only unrelated modules end up running side by side.
+void Application::BuildSchedule()
+{
+	schedule.clear();
+
+	for (size_t i = 0; i < list_modules.size(); ++i)
+	{
+		Module* module = list_modules[i];
+
+		bool newSegment = module->IsBarrier() || schedule.empty()
+			|| list_modules[schedule.back().nodes.back().module]->IsBarrier()
+			|| schedule.back().nodes.size() >= MAX_SCHEDULE_NODES;
+		if (newSegment)
+		{
+			schedule.push_back(ScheduleSegment());
+		}
+
+		ScheduleSegment& segment = schedule.back();
+		ScheduleNode node;
+		node.module = (int)i;
+		node.wave = 0;
+
+		if (!module->IsBarrier())
 		{
-			Module* module = *it;
-			if (module->IsEnabled())
+			for (size_t n = 0; n < segment.nodes.size(); ++n)
 			{
-				ret = module->PreUpdate();
+				if (list_modules[segment.nodes[n].module]->ConflictsWith(module))
+				{
+					node.dependencies.push_back((int)n);
+					node.wave = MAX(node.wave, segment.nodes[n].wave + 1);
+				}
 			}
 		}
 
-		for (auto it = list_modules.begin(); it != list_modules.end() && ret == UPDATE_CONTINUE; ++it)
+		if ((int)segment.waves.size() <= node.wave)
 		{
-			Module* module = *it;
-			if (module->IsEnabled())
+			segment.waves.resize(node.wave + 1);
+		}
+		segment.waves[node.wave].push_back((int)segment.nodes.size());
+		segment.nodes.push_back(node);
+	}
+
+	std::string description;
+	for (const ScheduleSegment& segment : schedule)
+	{
+		description += "[";
+		for (size_t n = 0; n < segment.nodes.size(); ++n)
+		{
+			const ScheduleNode& node = segment.nodes[n];
+			if (n > 0) description += " ";
+			description += list_modules[node.module]->GetName();
+
+			if (!node.dependencies.empty())
 			{
-				ret = module->Update();
+				description += "<-";
+				for (size_t d = 0; d < node.dependencies.size(); ++d)
+				{
+					if (d > 0) description += ",";
+					description += list_modules[segment.nodes[node.dependencies[d]].module]->GetName();
+				}
 			}
 		}
+		description += "] ";
+	}
+	LOG("Module schedule: %s", description.c_str());
+}
+
+// Run one phase on every enabled module
+// PreUpdate, FixedUpdate and Update follow the schedule on the job system.
+// PostUpdate draws, so it always runs on the main thread in list order.
+update_status Application::RunPhaseOnModules(ProfilePhase phase)
+{
+	update_status ret = UPDATE_CONTINUE;
 
-		for (auto it = list_modules.begin(); it != list_modules.end() && ret == UPDATE_CONTINUE; ++it)
+	if (phase == PHASE_POST_UPDATE || jobs->GetWorkerCount() == 0)
+	{
+		for (size_t i = 0; i < list_modules.size() && ret == UPDATE_CONTINUE; ++i)
 		{
-			Module* module = *it;
-			if (module->IsEnabled())
+			Module* module = list_modules[i];
+			if (!module->IsEnabled()) continue;
+			if (config.headless && IsPresentationModule(module)) continue;
+
+			ret = RunPhase(module, phase, (int)i);
+		}
+		return ret;
+	}
+
+	for (size_t s = 0; s < schedule.size() && ret == UPDATE_CONTINUE; ++s)
+	{
+		ret = RunSegment(schedule[s], phase);
+	}
+
+	return ret;
+}
+
+// Waves run one after another, the modules of a wave side by side as one job each
+// Jobs never wait: a module simply runs to the end, and the only thread that waits is
+// the one running the segment, inside ParallelFor's help loop. A module that forks its
+// own ParallelFor (NPCManager) can therefore help with anything it picks up - at worst
+// another module of the same wave - without ending up beneath a job that waits for it.
+// A module asking to stop doesn't cancel the rest of its segment, only later segments
+update_status Application::RunSegment(const ScheduleSegment& segment, ProfilePhase phase)
+{
+	update_status results[MAX_SCHEDULE_NODES];
+	int runnable[MAX_SCHEDULE_NODES];
+
+	int nodeCount = (int)segment.nodes.size();
+	for (int n = 0; n < nodeCount; ++n)
+	{
+		results[n] = UPDATE_CONTINUE;
+	}
+
+	for (const std::vector<int>& wave : segment.waves)
+	{
+		int count = 0;
+		for (int n : wave)
+		{
+			Module* module = list_modules[segment.nodes[n].module];
+			if (!module->IsEnabled() || (config.headless && IsPresentationModule(module))) continue;
+			runnable[count++] = n;
+		}
+
+		// Barriers, lone modules and waves thinned out by disabled modules stay on this thread
+		if (count == 0) continue;
+		if (count == 1)
+		{
+			int index = segment.nodes[runnable[0]].module;
+			results[runnable[0]] = RunPhase(list_modules[index], phase, index);
+			continue;
+		}
+
+		jobs->ParallelFor(count, 1, [&](int begin, int end) {
+			for (int i = begin; i < end; ++i)
 			{
-				ret = module->PostUpdate();
+				int index = segment.nodes[runnable[i]].module;
+				results[runnable[i]] = RunPhase(list_modules[index], phase, index);
 			}
+		});
+	}
+
+	// Report the first module (in list order) that asked to stop
+	for (int n = 0; n < nodeCount; ++n)
+	{
+		if (results[n] != UPDATE_CONTINUE) return results[n];
+	}
+	return UPDATE_CONTINUE;
+}
+
+// Run one phase on a single module, timing it for the profiler
+update_status Application::RunPhase(Module* module, ProfilePhase phase, int slot)
+{
+	if (slot < 0)
+	{
+		for (size_t i = 0; i < list_modules.size(); ++i)
+		{
+			if (list_modules[i] == module) { slot = (int)i; break; }
 		}
 	}
 
-	if (WindowShouldClose()) ret = UPDATE_STOP;
+	update_status ret = UPDATE_CONTINUE;
+	TRACE_BEGIN_CAT(module->GetName(), Profiler::GetPhaseName(phase));
+	MemoryScope memory(module->GetMemoryTag());
+	Timer timer;
 
+	switch (phase)
+	{
+	case PHASE_PRE_UPDATE: ret = module->PreUpdate(); break;
+	case PHASE_FIXED_UPDATE: ret = module->FixedUpdate(FIXED_TIMESTEP); break;
+	case PHASE_UPDATE: ret = module->Update(); break;
+	case PHASE_POST_UPDATE: ret = module->PostUpdate(); break;
+	default: break;
+	}
+
+	profiler.Record(slot, phase, timer.ReadMs());
+	TRACE_END();
 	return ret;
 }
 
+void Application::SaveState(std::vector<uint8_t>& buffer) const
+{
+	buffer.clear();
+	StateWriter writer(buffer);
+
+	writer.Write((uint32_t)STATE_MAGIC);
+	writer.Write((uint32_t)STATE_VERSION);
+	writer.Write(simulation_steps);
+	writer.Write(fixed_accumulator);
+	writer.Write(state_hash);
+	WriteSimulationState(writer);
+}
+
+void Application::WriteSimulationState(StateWriter& writer) const
+{
+	writer.Write(random);
+
+	// One section per module, empty for modules without simulation state
+	for (const Module* module : list_modules)
+	{
+		size_t section = writer.BeginSection();
+		if (module->IsEnabled()) module->SaveState(writer);
+		writer.EndSection(section);
+	}
+}
+
+bool Application::UpdateStateHash()
+{
+	if (!state_hash_enabled)
+		return true;
+
+	SCOPED_TIMER("Application::UpdateStateHash");
+
+	hash_buffer.clear();
+	StateWriter writer(hash_buffer);
+	WriteSimulationState(writer);
+	state_hash = xxh64(hash_buffer.data(), hash_buffer.size(), state_hash);
+
+	// A desync fails the run (non-zero exit), so scripts and CI notice it
+	if (!hash_log.Step(simulation_steps, state_hash))
+	{
+		LOG_ERR("Stopping - the simulation diverged from '%s'", config.hashCheckPath);
+		return false;
+	}
+	return true;
+}
+
+bool Application::LoadState(const std::vector<uint8_t>& buffer)
+{
+	StateReader reader(buffer.data(), buffer.size());
+
+	uint32_t magic = 0, version = 0;
+	if (!reader.Read(magic) || !reader.Read(version) || magic != STATE_MAGIC || version != STATE_VERSION)
+	{
+		LOG_ERR("Snapshot rejected - not a state snapshot or from another version");
+		return false;
+	}
+
+	uint64 steps = 0;
+	float accumulator = 0.0f;
+	uint64_t hash = 0;
+	Random raceRandom;
+	reader.Read(steps);
+	reader.Read(accumulator);
+	reader.Read(hash);
+	reader.Read(raceRandom);
+
+	for (Module* module : list_modules)
+	{
+		StateReader section = reader.ReadSection();
+		if (!section.IsValid())
+		{
+			LOG_ERR("Snapshot truncated at module %s", module->GetName());
+			return false;
+		}
+
+		if (!module->IsEnabled()) continue;
+		if (!module->LoadState(section) || !section.IsComplete())
+		{
+			LOG_ERR("Snapshot doesn't match module %s", module->GetName());
+			return false;
+		}
+	}
+
+	simulation_steps = steps;
+	fixed_accumulator = accumulator;
+	state_hash = hash;
+	random = raceRandom;
+	return true;
+}
+
+// F5 keeps a snapshot of the race, F9 goes back to it
+void Application::HandleQuickSave()
+{
+	if (IsKeyPressed(KEY_F5))
+	{
+		Timer timer;
+		SaveState(quick_save);
+		LOG("Quick save: %d bytes in %.3f ms (step %llu)", (int)quick_save.size(), timer.ReadMs(), (unsigned long long)simulation_steps);
+	}
+	else if (IsKeyPressed(KEY_F9) && !quick_save.empty())
+	{
+		Timer timer;
+		if (LoadState(quick_save))
+		{
+			LOG("Quick load: back to step %llu in %.3f ms", (unsigned long long)simulation_steps, timer.ReadMs());
+		}
+	}
+}
+
+void Application::LogMemoryReport() const
+{
+	MemoryCounters total;
+	memory_snapshot(total);
+
+	LOG("Heap allocations: %llu of %llu race frames allocated after warm-up",
+		(unsigned long long)memory_race_frames_allocating, (unsigned long long)memory_race_frames);
+	for (int tag = 0; tag < MEM_TAG_COUNT; ++tag)
+	{
+		if (total.calls[tag] == 0) continue;
+		LOG("  %-9s %9llu calls %10.1f KB since startup | race %6llu calls %8.1f KB | live %8.1f KB",
+			memory_tag_name((MemoryTag)tag),
+			(unsigned long long)total.calls[tag], total.bytes[tag] / 1024.0,
+			(unsigned long long)memory_race.calls[tag], memory_race.bytes[tag] / 1024.0,
+			total.live[tag] / 1024.0);
+	}
+}
+
+// Frame statistics: profiler history, quality level, startup counters and frames-per-second counter
+void Application::FinishFrame(bool raceFrame)
+{
+	profiler.EndFrame(frame_time.ReadMs());
+
+	// Only race frames are measured against the budget - the menus are cheap and may sit idle
+	if (!config.headless && raceFrame)
+	{
+		quality_governor.Update(frame_pacer.GetLastWorkMs(), frame_pacer.GetFrameBudgetMs());
+	}
+
+	if (frame_count == 0)
+	{
+		time_to_first_frame = startup_time.ReadSec();
+		LOG("Time to first frame: %.1f ms", time_to_first_frame * 1000.0);
+	}
+	if (race_start_pending && raceFrame)
+	{
+		race_start_pending = false;
+		race_frames = 0;
+		time_to_race_start = race_start_time.ReadSec();
+		LOG("Time to race start: %.1f ms", time_to_race_start * 1000.0);
+	}
+
+	// Allocations this frame, and in race frames once warm-up is over (the zero-allocation goal)
+	MemoryCounters memoryNow;
+	memory_snapshot(memoryNow);
+	memory_frame = memory_diff(memory_frame_start, memoryNow);
+
+	if (raceFrame && ++race_frames > MEMORY_WARMUP_FRAMES)
+	{
+		memory_race_frames++;
+		if (memory_frame.TotalCalls() > 0) memory_race_frames_allocating++;
+		for (int tag = 0; tag < MEM_TAG_COUNT; ++tag)
+		{
+			memory_race.calls[tag] += memory_frame.calls[tag];
+			memory_race.bytes[tag] += memory_frame.bytes[tag];
+			memory_race.live[tag] = memory_frame.live[tag];
+		}
+	}
+
+	frame_count++;
+	last_sec_frame_count++;
+	if (last_sec_frame_time.ReadSec() >= 1.0)
+	{
+		prev_last_sec_frame_count = last_sec_frame_count;
+		last_sec_frame_count = 0;
+		last_sec_frame_time.Start();
+	}
+}
+
 bool Application::CleanUp()
 {
 	bool ret = true;
 	for (auto it = list_modules.rbegin(); it != list_modules.rend() && ret; ++it)
 	{
 		Module* item = *it;
+		if (config.headless && IsPresentationModule(item)) continue;
+
+		// Cached tracks outlive Map's enable / disable cycles - free them while the
+		// resource manager can still release their textures
+		if (item == resources) tracks->EvictAll(resources);
+
+		MemoryScope memory(item->GetMemoryTag());
 		ret = item->CleanUp();
 	}
 
+	jobs->Shutdown();
+	input_recorder.Close();
+	hash_log.Close();
+
+	if (config.tracePath != nullptr)
+	{
+		trace_dump(config.tracePath);
+	}
+
 	return ret;
 }
 
-void Application::AddModule(Module* mod)
+void Application::AddModule(Module* mod, const char* name, MemoryTag memoryTag)
 {
+	mod->SetName(name);
+	mod->SetMemoryTag(memoryTag);
 	list_modules.emplace_back(mod);
+
+	// Profiler slots follow list order, so a module's slot is its index
+	profiler.AddSlot(name);
+}
+
+bool Application::IsPresentationModule(const Module* module) const
+{
+	return module == window || module == audio || module == renderer || module == intro || module == mainMenu;
 }
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "core/EventBus.h"
+#include "core/Timer.h"
+#include "core/Trace.h"
+#include "entities/PhysBody.h"
+#include "modules/ModuleRender.h"
+#include "modules/ModuleAudio.h"
+
+void EventBus::PostContact(PhysBody* bodyA, PhysBody* bodyB, bool begin)
+{
+	// A lost BeginContact would lose a checkpoint crossing - spill instead of dropping
+	if (contacts.IsFull())
+	{
+		contactSpill.push_back({ bodyA, bodyB, begin });
+		return;
+	}
+	contacts.Push({ bodyA, bodyB, begin });
+}
+
+ContactEvent& EventBus::GetContact(int index)
+{
+	return (index < contacts.GetCount()) ? contacts[index] : contactSpill[index - contacts.GetCount()];
+}
+
+void EventBus::PostScreenShake(float amount)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	screenShakes.Push({ amount });
+}
+
+void EventBus::PostSound(unsigned int fxId)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	sounds.Push({ fxId });
+}
+
+void EventBus::PurgeBody(const PhysBody* body)
+{
+	for (int i = 0; i < GetContactCount(); ++i)
+	{
+		ContactEvent& event = GetContact(i);
+		if (event.bodyA == body) event.bodyA = nullptr;
+		if (event.bodyB == body) event.bodyB = nullptr;
+	}
+}
+
+void EventBus::DispatchContacts()
+{
+	if (GetContactCount() == 0)
+		return;
+
+	TRACE_ZONE("EventBus::DispatchContacts");
+	Timer timer;
+
+	// A listener that destroys a body posts more contacts - the count is re-read
+	for (int i = 0; i < GetContactCount(); ++i)
+	{
+		const ContactEvent event = GetContact(i);
+		PhysBody* bodyA = event.bodyA;
+		PhysBody* bodyB = event.bodyB;
+
+		if (bodyA && bodyA->GetCollisionListener())
+		{
+			if (event.begin) bodyA->GetCollisionListener()->OnCollisionEnter(bodyB);
+			else bodyA->GetCollisionListener()->OnCollisionExit(bodyB);
+		}
+
+		// Re-read, the first listener may have purged a body
+		bodyA = GetContact(i).bodyA;
+		bodyB = GetContact(i).bodyB;
+		if (bodyB && bodyB->GetCollisionListener())
+		{
+			if (event.begin) bodyB->GetCollisionListener()->OnCollisionEnter(bodyA);
+			else bodyB->GetCollisionListener()->OnCollisionExit(bodyA);
+		}
+	}
+
+	if (!contactSpill.empty())
+	{
+		LOG_WARN("%d contacts past MAX_CONTACT_EVENTS (%d) in one step - raise it", (int)contactSpill.size(), MAX_CONTACT_EVENTS);
+	}
+
+	frame.contacts += GetContactCount();
+	frame.contactSpills += (uint32)contactSpill.size();
+	frame.dispatchMs += timer.ReadMs();
+	contacts.Clear();
+	contactSpill.clear();
+}
+
+void EventBus::DispatchFrameEvents(ModuleRender* renderer, ModuleAudio* audio)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (screenShakes.GetCount() == 0 && sounds.GetCount() == 0)
+		return;
+
+	TRACE_ZONE("EventBus::DispatchFrameEvents");
+	Timer timer;
+
+	for (int i = 0; i < screenShakes.GetCount(); ++i)
+	{
+		if (renderer) renderer->AddScreenShake(screenShakes[i].amount);
+	}
+	for (int i = 0; i < sounds.GetCount(); ++i)
+	{
+		if (audio) audio->PlayFx(sounds[i].fxId);
+	}
+
+	frame.screenShakes += screenShakes.GetCount();
+	frame.sounds += sounds.GetCount();
+	frame.dropped += screenShakes.TakeDropped() + sounds.TakeDropped();
+	frame.dispatchMs += timer.ReadMs();
+	screenShakes.Clear();
+	sounds.Clear();
+}
+
+void EventBus::Clear()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	contacts.Clear();
+	contactSpill.clear();
+	screenShakes.Clear();
+	sounds.Clear();
+}
+
+void EventBus::BeginFrame()
+{
+	lastFrame = frame;
+	frame = EventStats();
+}
@@ -0,0 +1,190 @@
+#include "core/FramePacer.h"
+#include "core/Trace.h"
+
+#include "raylib.h"
+
+// Refresh rate assumed when the monitor doesn't report one
+#define PACER_FALLBACK_REFRESH_RATE 60
+
+static const char* const framePacingNames[FRAME_PACING_COUNT] = { "vsync", "just-in-time", "uncapped" };
+
+static double ElapsedSec(uint64_t from, uint64_t to)
+{
+	return clock_ticks_to_sec(to - from);
+}
+
+static int RefreshRate()
+{
+	int refreshRate = GetMonitorRefreshRate(GetCurrentMonitor());
+	return (refreshRate > 0) ? refreshRate : PACER_FALLBACK_REFRESH_RATE;
+}
+
+static double Smooth(double average, double sample)
+{
+	return average + (sample - average) * PACER_STATS_SMOOTHING;
+}
+
+void FramePacer::Init(FramePacing initialMode, int initialFrameCap)
+{
+	windowReady = true;
+	frameCap = initialFrameCap > 0 ? initialFrameCap : 0;
+	inputAt = clock_ticks();
+	SetMode(initialMode);
+}
+
+const char* FramePacer::GetModeName(FramePacing pacing)
+{
+	return (pacing < FRAME_PACING_COUNT) ? framePacingNames[pacing] : "?";
+}
+
+bool FramePacer::IsModeAvailable(FramePacing pacing)
+{
+#ifdef SUPPORT_CUSTOM_FRAME_CONTROL
+	return pacing < FRAME_PACING_COUNT;
+#else
+	return pacing < FRAME_PACING_COUNT && pacing != FRAME_PACING_JUST_IN_TIME;
+#endif
+}
+
+void FramePacer::SetMode(FramePacing pacing)
+{
+	if (!IsModeAvailable(pacing))
+	{
+		LOG_WARN("Frame pacing '%s' needs raylib built with SUPPORT_CUSTOM_FRAME_CONTROL - using vsync", GetModeName(pacing));
+		pacing = FRAME_PACING_VSYNC;
+	}
+	mode = pacing;
+
+	if (!windowReady)
+		return;
+
+	if (mode == FRAME_PACING_UNCAPPED) ClearWindowState(FLAG_VSYNC_HINT);
+	else SetWindowState(FLAG_VSYNC_HINT);
+
+#ifdef SUPPORT_CUSTOM_FRAME_CONTROL
+	// raylib doesn't wait any more, BeginFrame does
+	SetTargetFPS(0);
+#else
+	SetTargetFPS(idle ? GetIdleCap() : frameCap);
+#endif
+
+	LOG("Frame pacing: %s, frame cap %d", GetModeName(mode), frameCap);
+}
+
+void FramePacer::SetIdle(bool isIdle)
+{
+	if (isIdle == idle)
+		return;
+	idle = isIdle;
+
+#ifndef SUPPORT_CUSTOM_FRAME_CONTROL
+	// raylib does the waiting, hand it the lower rate
+	if (windowReady) SetTargetFPS(idle ? GetIdleCap() : frameCap);
+#endif
+}
+
+void FramePacer::NextMode()
+{
+	FramePacing next = mode;
+	do
+	{
+		next = (FramePacing)((next + 1) % FRAME_PACING_COUNT);
+	} while (!IsModeAvailable(next));
+
+	SetMode(next);
+}
+
+double FramePacer::GetFrameBudgetMs() const
+{
+	int refreshRate = RefreshRate();
+	int fps = (mode == FRAME_PACING_UNCAPPED) ? frameCap : refreshRate;
+	if (frameCap > 0 && frameCap < fps) fps = frameCap;
+	if (fps <= 0) fps = refreshRate;  // uncapped without a cap: keep up with the display
+	return 1000.0 / fps;
+}
+
+int FramePacer::GetIdleCap() const
+{
+	// Idle never runs faster than the cap
+	return (frameCap > 0 && frameCap < PACER_IDLE_FPS) ? frameCap : PACER_IDLE_FPS;
+}
+
+double FramePacer::PredictWorkSec() const
+{
+	// The slowest recent frame - a missed vblank costs a whole refresh, a little sleep doesn't
+	float worst = 0.0f;
+	for (int i = 0; i < PACER_WORK_HISTORY; ++i)
+	{
+		if (workHistory[i] > worst) worst = workHistory[i];
+	}
+	return worst;
+}
+
+void FramePacer::Sleep(double seconds)
+{
+	if (seconds <= 0.0)
+		return;
+
+	TRACE_ZONE("FramePacer::Sleep");
+	WaitTime(seconds);
+}
+
+void FramePacer::BeginFrame()
+{
+	uint64_t now = clock_ticks();
+
+#ifdef SUPPORT_CUSTOM_FRAME_CONTROL
+	double wait = 0.0;
+	if (idle)
+	{
+		// Nothing changes on screen, the mode's latency goals don't matter
+		wait = 1.0 / GetIdleCap() - ElapsedSec(inputAt, now);
+	}
+	else if (mode == FRAME_PACING_JUST_IN_TIME && havePresented)
+	{
+		// Wake up just in time to finish the frame before the next vertical blank
+		double budget = PredictWorkSec() + PACER_SAFETY_MARGIN_MS / 1000.0;
+		wait = 1.0 / RefreshRate() - budget - ElapsedSec(presentedAt, now);
+	}
+	else if (frameCap > 0)
+	{
+		// Frames start no closer than the cap allows
+		wait = 1.0 / frameCap - ElapsedSec(inputAt, now);
+	}
+	Sleep(wait);
+
+	PollInputEvents();
+	uint64_t polled = clock_ticks();
+	sleepMs = Smooth(sleepMs, ElapsedSec(now, polled) * 1000.0);
+	inputAt = polled;
+#else
+	// EndDrawing waited and polled at the end of the last frame
+	sleepMs = 0.0;
+	inputAt = havePresented ? presentedAt : now;
+#endif
+}
+
+void FramePacer::Present()
+{
+	uint64_t workDone = clock_ticks();
+	double work = ElapsedSec(inputAt, workDone);
+
+	EndDrawing();
+#ifdef SUPPORT_CUSTOM_FRAME_CONTROL
+	SwapScreenBuffer();
+	uint64_t swappedAt = clock_ticks();
+#else
+	// raylib swapped first, then waited for the frame cap
+	uint64_t swappedAt = workDone;
+#endif
+
+	presentedAt = clock_ticks();
+	havePresented = true;
+
+	workHistory[workIndex] = (float)work;
+	workIndex = (workIndex + 1) % PACER_WORK_HISTORY;
+
+	lastWorkMs = work * 1000.0;
+	workMs = Smooth(workMs, lastWorkMs);
+	inputToPresentMs = Smooth(inputToPresentMs, ElapsedSec(inputAt, swappedAt) * 1000.0);
+}
@@ -0,0 +1,133 @@
+#include "core/InputRecorder.h"
+
+#include <string.h>
+
+InputRecorder::InputRecorder()
+{
+}
+
+InputRecorder::~InputRecorder()
+{
+	Close();
+}
+
+bool InputRecorder::StartRecording(const char* path, uint32 recordSeed)
+{
+	Close();
+
+	file = fopen(path, "wb");
+	if (file == nullptr)
+	{
+		LOG_ERR("Could not open input recording '%s'", path);
+		return false;
+	}
+
+	char magic[INPUT_FILE_MAGIC_SIZE] = INPUT_FILE_MAGIC;
+	fwrite(magic, 1, INPUT_FILE_MAGIC_SIZE, file);
+	fwrite(&recordSeed, sizeof(recordSeed), 1, file);
+
+	recording = true;
+	finished = false;
+	seed = recordSeed;
+	steps = 0;
+	runInput = 0;
+	runLength = 0;
+
+	LOG("Recording player input to '%s' (seed %u)", path, seed);
+	return true;
+}
+
+bool InputRecorder::StartPlayback(const char* path)
+{
+	Close();
+
+	file = fopen(path, "rb");
+	if (file == nullptr)
+	{
+		LOG_ERR("Could not open input replay '%s'", path);
+		return false;
+	}
+
+	char magic[INPUT_FILE_MAGIC_SIZE] = {};
+	if (fread(magic, 1, INPUT_FILE_MAGIC_SIZE, file) != INPUT_FILE_MAGIC_SIZE ||
+		memcmp(magic, INPUT_FILE_MAGIC, INPUT_FILE_MAGIC_SIZE) != 0 ||
+		fread(&seed, sizeof(seed), 1, file) != 1)
+	{
+		LOG_ERR("'%s' is not an input replay", path);
+		fclose(file);
+		file = nullptr;
+		return false;
+	}
+
+	recording = false;
+	finished = false;
+	steps = 0;
+	runInput = 0;
+	runLength = 0;
+
+	LOG("Replaying player input from '%s' (seed %u)", path, seed);
+	return true;
+}
+
+void InputRecorder::Close()
+{
+	if (file == nullptr)
+		return;
+
+	if (recording)
+	{
+		WriteRun();
+		LOG("Input recording closed - %llu steps", (unsigned long long)steps);
+	}
+
+	fclose(file);
+	file = nullptr;
+}
+
+void InputRecorder::Record(PlayerInput input)
+{
+	if (!IsRecording())
+		return;
+
+	if (runLength > 0 && (input != runInput || runLength == INPUT_MAX_RUN))
+	{
+		WriteRun();
+	}
+
+	runInput = input;
+	runLength++;
+	steps++;
+}
+
+PlayerInput InputRecorder::Next()
+{
+	if (!IsPlaying() || finished)
+		return 0;
+
+	while (runLength == 0)
+	{
+		uint16_t length = 0;
+		if (fread(&runInput, sizeof(runInput), 1, file) != 1 || fread(&length, sizeof(length), 1, file) != 1)
+		{
+			finished = true;
+			LOG("Input replay finished after %llu steps", (unsigned long long)steps);
+			return 0;
+		}
+		runLength = length;
+	}
+
+	runLength--;
+	steps++;
+	return runInput;
+}
+
+void InputRecorder::WriteRun()
+{
+	if (runLength == 0)
+		return;
+
+	uint16_t length = (uint16_t)runLength;
+	fwrite(&runInput, sizeof(runInput), 1, file);
+	fwrite(&length, sizeof(length), 1, file);
+	runLength = 0;
+}
@@ -0,0 +1,222 @@
+#include "core/JobSystem.h"
+#include "core/Trace.h"
+
+// Which job system (and which of its queues) the current thread owns
+static thread_local const JobSystem* threadSystem = nullptr;
+static thread_local int threadQueue = -1;
+
+JobSystem::JobSystem() : queuedJobs(0), running(false)
+{
+}
+
+JobSystem::~JobSystem()
+{
+	Shutdown();
+}
+
+bool JobSystem::Init(int workerCount)
+{
+	if (running) return true;
+
+	if (workerCount < 0)
+	{
+		int hardware = (int)std::thread::hardware_concurrency();
+		workerCount = (hardware > 1) ? hardware - 1 : 0;
+	}
+	if (workerCount > JOB_MAX_WORKERS) workerCount = JOB_MAX_WORKERS;
+
+	running = true;
+
+	for (int i = 0; i <= workerCount; ++i)
+	{
+		queues.push_back(new JobQueue());
+	}
+
+	threadSystem = this;
+	threadQueue = 0;
+
+	for (int i = 1; i <= workerCount; ++i)
+	{
+		workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+	}
+
+	LOG("Job system started with %d worker threads", workerCount);
+	return true;
+}
+
+void JobSystem::Shutdown()
+{
+	if (!running) return;
+
+	{
+		std::lock_guard<std::mutex> lock(wakeMutex);
+		running = false;
+	}
+	wakeCondition.notify_all();
+
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+	workers.clear();
+
+	for (JobQueue* queue : queues)
+	{
+		delete queue;
+	}
+	queues.clear();
+
+	if (threadSystem == this)
+	{
+		threadSystem = nullptr;
+		threadQueue = -1;
+	}
+}
+
+void JobSystem::ParallelFor(int count, int grainSize, const RangeFunc& body)
+{
+	if (count <= 0) return;
+	if (grainSize < 1) grainSize = 1;
+
+	// Nothing to share the work with - or a thread that can't fork - run inline
+	int queueIndex = (threadSystem == this) ? threadQueue : -1;
+	if (workers.empty() || queueIndex < 0 || count <= grainSize)
+	{
+		body(0, count);
+		return;
+	}
+
+	int chunks = (count + grainSize - 1) / grainSize;
+	std::atomic<int> pending(chunks);
+	MemoryTag memoryTag = memory_get_tag();
+
+	// Chunks past the queue's capacity are run here, after the queued ones are shared out
+	int overflowBegin = count;
+	{
+		JobQueue* queue = queues[queueIndex];
+		std::lock_guard<std::mutex> lock(queue->mutex);
+		for (int begin = 0; begin < count; begin += grainSize)
+		{
+			int end = (begin + grainSize < count) ? begin + grainSize : count;
+			if (!queue->PushBack({ &body, begin, end, &pending, memoryTag }))
+			{
+				overflowBegin = begin;
+				break;
+			}
+			queuedJobs++;
+		}
+	}
+
+	// Taking the lock orders this with a worker that is about to wait
+	{
+		std::lock_guard<std::mutex> lock(wakeMutex);
+	}
+	wakeCondition.notify_all();
+
+	for (int begin = overflowBegin; begin < count; begin += grainSize)
+	{
+		int end = (begin + grainSize < count) ? begin + grainSize : count;
+		Execute({ &body, begin, end, &pending, memoryTag });
+	}
+
+	// Help until our own chunks are done (this may also run other threads' jobs)
+	while (pending.load(std::memory_order_acquire) > 0)
+	{
+		Job job;
+		if (PopOrSteal(queueIndex, job))
+		{
+			Execute(job);
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::WorkerLoop(int queueIndex)
+{
+	threadSystem = this;
+	threadQueue = queueIndex;
+	trace_set_thread_name("Job Worker");
+
+	while (true)
+	{
+		Job job;
+		if (PopOrSteal(queueIndex, job))
+		{
+			Execute(job);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(wakeMutex);
+		wakeCondition.wait(lock, [this]() { return !running || queuedJobs.load() > 0; });
+		if (!running) break;
+	}
+}
+
+bool JobSystem::PopOrSteal(int queueIndex, Job& job)
+{
+	// Own queue first, newest job (its data is most likely still in cache)
+	{
+		JobQueue* queue = queues[queueIndex];
+		std::lock_guard<std::mutex> lock(queue->mutex);
+		if (queue->PopBack(job))
+		{
+			queuedJobs--;
+			return true;
+		}
+	}
+
+	// Steal the oldest job from someone else
+	int queueCount = (int)queues.size();
+	for (int offset = 1; offset < queueCount; ++offset)
+	{
+		JobQueue* victim = queues[(queueIndex + offset) % queueCount];
+		std::lock_guard<std::mutex> lock(victim->mutex);
+		if (victim->PopFront(job))
+		{
+			queuedJobs--;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void JobSystem::Execute(const Job& job)
+{
+	TRACE_ZONE_CAT("Job", "job");
+	MemoryScope memory(job.memoryTag);
+
+	(*job.body)(job.begin, job.end);
+	job.pending->fetch_sub(1, std::memory_order_release);
+}
+
+bool JobSystem::JobQueue::PushBack(const Job& job)
+{
+	if (count == JOB_QUEUE_CAPACITY) return false;
+
+	jobs[(front + count) % JOB_QUEUE_CAPACITY] = job;
+	count++;
+	return true;
+}
+
+bool JobSystem::JobQueue::PopBack(Job& job)
+{
+	if (count == 0) return false;
+
+	count--;
+	job = jobs[(front + count) % JOB_QUEUE_CAPACITY];
+	return true;
+}
+
+bool JobSystem::JobQueue::PopFront(Job& job)
+{
+	if (count == 0) return false;
+
+	job = jobs[front];
+	front = (front + 1) % JOB_QUEUE_CAPACITY;
+	count--;
+	return true;
+}
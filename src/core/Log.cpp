@@ -1,19 +1,407 @@
-#pragma once
-
 #include "core/Globals.h"
+#include "core/Timer.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Longest line the writer expands a record into
+#define LOG_LINE_SIZE 1024
+
+// Longest the idle writer sleeps before it looks at the queue again (ms)
+#define LOG_WRITER_IDLE_MS 100
+
+// Bounded multi-producer / single-consumer ring. Each slot's sequence number tells
+// producers when it is free and the writer when its record is complete, so
+// producers only ever contend on one atomic increment.
+struct LogSlot
+{
+	std::atomic<size_t> sequence;
+	const LogSite* site;
+	int64_t timestampNs;
+	uint8_t type;           // LOG_RECORD_MESSAGE or LOG_RECORD_SUPPRESSED
+	uint16_t size;
+	uint8_t payload[LOG_PAYLOAD_SIZE];
+};
+
+static LogSlot slots[LOG_QUEUE_SIZE];
+static std::atomic<size_t> enqueuePos(0);
+static size_t dequeuePos = 0;          // Writer thread only
+static std::atomic<int> dropped(0);
+static std::atomic<uint32_t> nextSiteId(1);
+
+static std::thread writer;
+static std::atomic<bool> writerStop(false);
+static std::atomic<bool> writerStopped(false);
+
+// The writer sleeps on wakeCondition when the queue is empty. Producers only take
+// wakeMutex to notify while writerIdle is set, so a busy writer costs them nothing.
+static std::mutex wakeMutex;
+static std::condition_variable wakeCondition;
+static std::atomic<bool> writerIdle(false);
+
+// Used once the writer has stopped - messages are written from the calling thread
+static std::mutex directMutex;
+static LogSlot directSlot;
+
+// Binary output, written by the writer thread (or under directMutex after it stopped)
+static std::atomic<FILE*> binaryFile(nullptr);
+static std::vector<bool> sitesWritten;
+
+// A joinable std::thread must not be destroyed - stop the writer before statics go away
+struct LogShutdownGuard
+{
+	~LogShutdownGuard() { log_shutdown(); }
+};
+static LogShutdownGuard shutdownGuard;
+
+static int64_t LogNowNs()
+{
+	return (int64_t)clock_now_ns();
+}
+
+// === WRITER ===
+static void WriteBinaryString(FILE* file, const char* text)
+{
+	uint16_t length = (uint16_t)strlen(text);
+	fwrite(&length, sizeof(length), 1, file);
+	fwrite(text, 1, length, file);
+}
+
+static void WriteBinary(FILE* file, const LogSlot& slot)
+{
+	const LogSite* site = slot.site;
+	uint32_t id = site->id.load();
+
+	// The site (file, line and format string) goes out once, before its first record
+	if (id >= sitesWritten.size()) sitesWritten.resize(id + 64, false);
+	if (!sitesWritten[id])
+	{
+		uint8_t type = LOG_RECORD_SITE;
+		uint8_t level = (uint8_t)site->level;
+		uint32_t line = (uint32_t)site->line;
+		fwrite(&type, 1, 1, file);
+		fwrite(&id, sizeof(id), 1, file);
+		fwrite(&level, 1, 1, file);
+		fwrite(&line, sizeof(line), 1, file);
+		WriteBinaryString(file, site->file);
+		WriteBinaryString(file, site->format);
+		sitesWritten[id] = true;
+	}
+
+	fwrite(&slot.type, 1, 1, file);
+	fwrite(&id, sizeof(id), 1, file);
+	fwrite(&slot.timestampNs, sizeof(slot.timestampNs), 1, file);
+
+	if (slot.type == LOG_RECORD_MESSAGE)
+	{
+		fwrite(&slot.size, sizeof(slot.size), 1, file);
+		fwrite(slot.payload, 1, slot.size, file);
+	}
+	else
+	{
+		fwrite(slot.payload, sizeof(uint32_t), 1, file);
+	}
+}
+
+static void WriteText(const LogSlot& slot)
+{
+	const LogSite* site = slot.site;
+	char line[LOG_LINE_SIZE];
+
+	if (slot.type == LOG_RECORD_MESSAGE)
+	{
+		log_format_payload(site->format, slot.payload, slot.size, line, sizeof(line));
+	}
+	else
+	{
+		uint32_t count = 0;
+		memcpy(&count, slot.payload, sizeof(count));
+		snprintf(line, sizeof(line), "(%u similar messages suppressed)", count);
+	}
+
+	printf("\n%s(%d) : %s%s", site->file, site->line, log_level_prefix(site->level), line);
+}
+
+static void WriteRecord(const LogSlot& slot)
+{
+	FILE* file = binaryFile.load();
+	if (file != nullptr)
+	{
+		WriteBinary(file, slot);
+		if (slot.site->level < LOG_LEVEL_WARNING) return;
+	}
+	WriteText(slot);
+}
+
+static void WriteDropped(int count)
+{
+	FILE* file = binaryFile.load();
+	if (file != nullptr)
+	{
+		uint8_t type = LOG_RECORD_DROPPED;
+		uint32_t lost = (uint32_t)count;
+		fwrite(&type, 1, 1, file);
+		fwrite(&lost, sizeof(lost), 1, file);
+	}
+	printf("\n%d log messages dropped (queue full)", count);
+}
+
+// Write every complete record, returns how many there were
+static int DrainQueue()
+{
+	int written = 0;
+	while (true)
+	{
+		LogSlot& slot = slots[dequeuePos % LOG_QUEUE_SIZE];
+		if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1)
+			break;
+
+		WriteRecord(slot);
+		slot.sequence.store(dequeuePos + LOG_QUEUE_SIZE, std::memory_order_release);
+		dequeuePos++;
+		written++;
+	}
+
+	int lost = dropped.exchange(0);
+	if (lost > 0) WriteDropped(lost);
+
+	if (written > 0 || lost > 0)
+	{
+		fflush(stdout);
+		FILE* file = binaryFile.load();
+		if (file != nullptr) fflush(file);
+	}
+	return written;
+}
+
+// Writer thread only
+static bool RecordReady()
+{
+	const LogSlot& slot = slots[dequeuePos % LOG_QUEUE_SIZE];
+	return slot.sequence.load(std::memory_order_acquire) == dequeuePos + 1;
+}
+
+static void WriterLoop()
+{
+	while (true)
+	{
+		bool stopping = writerStop.load();
+		if (DrainQueue() > 0) continue;
+		if (stopping) break;
+
+		std::unique_lock<std::mutex> lock(wakeMutex);
+		writerIdle.store(true);
+		// Pairs with the fence in WakeWriter: either the producer sees writerIdle
+		// or the predicate below sees its record
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		wakeCondition.wait_for(lock, std::chrono::milliseconds(LOG_WRITER_IDLE_MS), []
+		{
+			return writerStop.load() || RecordReady() || dropped.load() > 0;
+		});
+		writerIdle.store(false);
+	}
+}
+
+static void WakeWriter()
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (!writerIdle.load(std::memory_order_relaxed)) return;
+
+	// Taking the lock makes sure the writer is already waiting, so the notify isn't lost
+	std::lock_guard<std::mutex> lock(wakeMutex);
+	wakeCondition.notify_one();
+}
+
+static bool StartWriter()
+{
+	for (size_t i = 0; i < LOG_QUEUE_SIZE; ++i)
+	{
+		slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	writer = std::thread(WriterLoop);
+	return true;
+}
+
+// === PRODUCERS ===
+// Claim the next ring slot, nullptr when the writer is a full ring behind
+// On success the slot's sequence still equals its position until it is published
+static LogSlot* ClaimSlot()
+{
+	static bool started = StartWriter();
+	(void)started;
+
+	size_t pos = enqueuePos.load(std::memory_order_relaxed);
+	while (true)
+	{
+		LogSlot* slot = &slots[pos % LOG_QUEUE_SIZE];
+		size_t sequence = slot->sequence.load(std::memory_order_acquire);
+		intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+
+		if (diff == 0)
+		{
+			if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				return slot;
+		}
+		else if (diff < 0)
+		{
+			// Writer is behind - never block the caller, just count it
+			dropped++;
+			return nullptr;
+		}
+		else
+		{
+			pos = enqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+static void PublishSlot(LogSlot* slot)
+{
+	// The writer waits for sequence == position + 1
+	size_t pos = slot->sequence.load(std::memory_order_relaxed);
+	slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+static void AssignSiteId(LogSite* site)
+{
+	if (site->id.load(std::memory_order_acquire) != 0) return;
+
+	// Two threads racing on a site's first message may burn an id, which is harmless
+	uint32_t expected = 0;
+	site->id.compare_exchange_strong(expected, nextSiteId++);
+}
+
+static void QueueSuppressed(LogSite* site, int count)
+{
+	LogSlot* slot = ClaimSlot();
+	if (slot == nullptr) return;
+
+	uint32_t muted = (uint32_t)count;
+	slot->site = site;
+	slot->timestampNs = LogNowNs();
+	slot->type = LOG_RECORD_SUPPRESSED;
+	slot->size = sizeof(muted);
+	memcpy(slot->payload, &muted, sizeof(muted));
+	PublishSlot(slot);
+}
+
+// Rate limit per call site: LOG_RATE_LIMIT messages per one second window
+static bool RateLimited(LogSite* site, int64_t now)
+{
+	int64_t windowStart = site->windowStart.load(std::memory_order_relaxed);
+	if (now - windowStart >= 1000000000LL && site->windowStart.compare_exchange_strong(windowStart, now))
+	{
+		site->windowCount.store(0);
+		int muted = site->suppressed.exchange(0);
+		if (muted > 0 && !writerStopped)
+		{
+			QueueSuppressed(site, muted);
+		}
+	}
+	if (site->windowCount.fetch_add(1) >= LOG_RATE_LIMIT)
+	{
+		site->suppressed++;
+		return true;
+	}
+	return false;
+}
+
+bool log_begin(LogSite* site, LogRecord& record)
+{
+	AssignSiteId(site);
+
+	// Not limited while a binary log is open - records are cheap there and loops
+	// like the map and checkpoint loaders should keep every line
+	int64_t now = LogNowNs();
+	if (binaryFile.load(std::memory_order_relaxed) == nullptr && RateLimited(site, now))
+		return false;
+
+	LogSlot* slot = nullptr;
+	if (writerStopped)
+	{
+		// Unlocked again in log_commit
+		directMutex.lock();
+		slot = &directSlot;
+	}
+	else
+	{
+		slot = ClaimSlot();
+		if (slot == nullptr) return false;
+	}
+
+	slot->site = site;
+	slot->timestampNs = now;
+	slot->type = LOG_RECORD_MESSAGE;
+
+	record.payload = slot->payload;
+	record.size = 0;
+	record.slot = slot;
+	return true;
+}
+
+void log_commit(LogRecord& record)
+{
+	LogSlot* slot = (LogSlot*)record.slot;
+	slot->size = (uint16_t)record.size;
+
+	if (slot == &directSlot)
+	{
+		WriteRecord(*slot);
+		fflush(stdout);
+		directMutex.unlock();
+		return;
+	}
+
+	PublishSlot(slot);
+	WakeWriter();
+}
+
+bool log_open_binary(const char* path)
+{
+	FILE* file = fopen(path, "wb");
+	if (file == nullptr)
+	{
+		LOG_ERR("Could not open binary log '%s'", path);
+		return false;
+	}
+
+	char magic[LOG_FILE_MAGIC_SIZE] = LOG_FILE_MAGIC;
+	fwrite(magic, 1, LOG_FILE_MAGIC_SIZE, file);
+
+	// Earlier messages already went to the console, the file starts here
+	log_flush();
+	FILE* previous = binaryFile.exchange(file);
+	if (previous != nullptr) fclose(previous);
+
+	LOG("Writing binary log to '%s' (console shows warnings and errors only)", path);
+	return true;
+}
+
+void log_flush()
+{
+	if (writerStopped || !writer.joinable()) return;
+
+	WakeWriter();
+	size_t target = enqueuePos.load();
+	while (true)
+	{
+		// The writer has moved past every message queued before this call
+		LogSlot& slot = slots[(target + LOG_QUEUE_SIZE - 1) % LOG_QUEUE_SIZE];
+		if (target == 0 || slot.sequence.load(std::memory_order_acquire) >= target - 1 + LOG_QUEUE_SIZE)
+			break;
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
+
+void log_shutdown()
+{
+	if (writerStopped) return;
 
-void log(const char file[], int line, const char* format, ...)
-{
-	static char tmp_string[4096];
-	static char tmp_string2[4096];
-	static va_list  ap;
-
-	// Construct the string from variable arguments
-	va_start(ap, format);
-	vsprintf_s(tmp_string, 4096, format, ap);
-	va_end(ap);
-	sprintf_s(tmp_string2, 4096, "\n%s(%d) : %s", file, line, tmp_string);
-	
-	// Output the log message
-	printf(tmp_string2);
-}
\ No newline at end of file
+	writerStop = true;
+	WakeWriter();
+	if (writer.joinable()) writer.join();
+	writerStopped = true;
+}
@@ -0,0 +1,182 @@
+#include "core/LogFormat.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+// Longest string argument expanded (the payload itself is smaller than this)
+#define LOG_FORMAT_MAX_STRING 1024
+
+const char* log_level_prefix(int level)
+{
+	switch (level)
+	{
+	case 0: return "DEBUG: ";
+	case 2: return "WARNING: ";
+	case 3: return "ERROR: ";
+	default: return "";
+	}
+}
+
+// Reads tagged arguments back out of a payload
+struct PayloadReader
+{
+	const uint8_t* data;
+	size_t size;
+	size_t offset;
+
+	bool Read(void* value, size_t bytes)
+	{
+		if (offset + bytes > size) return false;
+		memcpy(value, data + offset, bytes);
+		offset += bytes;
+		return true;
+	}
+};
+
+// Append printf output to out, keeping track of the remaining space
+static void Append(char* out, size_t outSize, size_t& length, const char* spec, ...)
+{
+	if (length + 1 >= outSize) return;
+
+	va_list args;
+	va_start(args, spec);
+	int written = vsnprintf(out + length, outSize - length, spec, args);
+	va_end(args);
+
+	if (written > 0)
+	{
+		length += ((size_t)written < outSize - length) ? (size_t)written : outSize - length - 1;
+	}
+}
+
+int log_format_payload(const char* format, const uint8_t* payload, size_t payloadSize, char* out, size_t outSize)
+{
+	if (outSize == 0) return 0;
+	out[0] = '\0';
+
+	PayloadReader reader = { payload, payloadSize, 0 };
+	size_t length = 0;
+
+	for (const char* c = format; *c && length + 1 < outSize; ++c)
+	{
+		if (*c != '%')
+		{
+			out[length++] = *c;
+			out[length] = '\0';
+			continue;
+		}
+
+		if (c[1] == '%')
+		{
+			out[length++] = '%';
+			out[length] = '\0';
+			++c;
+			continue;
+		}
+
+		// Copy flags, width and precision; drop length modifiers, the tag decides the size
+		// ('*' widths aren't supported)
+		char spec[32] = "%";
+		size_t specLength = 1;
+		const char* p = c + 1;
+		while (*p && strchr("-+ #0123456789.", *p) && specLength < sizeof(spec) - 4)
+		{
+			spec[specLength++] = *p++;
+		}
+		while (*p && strchr("hljztL", *p)) ++p;
+
+		char conversion = *p;
+		if (conversion == '\0') break;
+		c = p;
+
+		uint8_t tag = 0;
+		if (!reader.Read(&tag, 1))
+		{
+			Append(out, outSize, length, "<missing>");
+			continue;
+		}
+
+		switch (tag)
+		{
+		case LOG_ARG_INT:
+		{
+			int64_t value = 0;
+			reader.Read(&value, sizeof(value));
+			if (conversion == 'c')
+			{
+				spec[specLength++] = 'c'; spec[specLength] = '\0';
+				Append(out, outSize, length, spec, (int)value);
+			}
+			else if (strchr("fFeEgGaA", conversion))
+			{
+				spec[specLength++] = conversion; spec[specLength] = '\0';
+				Append(out, outSize, length, spec, (double)value);
+			}
+			else
+			{
+				bool isUnsigned = strchr("uxXo", conversion) != nullptr;
+				spec[specLength++] = 'l'; spec[specLength++] = 'l';
+				spec[specLength++] = isUnsigned ? conversion : 'd'; spec[specLength] = '\0';
+				Append(out, outSize, length, spec, (long long)value);
+			}
+			break;
+		}
+		case LOG_ARG_UINT:
+		{
+			uint64_t value = 0;
+			reader.Read(&value, sizeof(value));
+			if (strchr("fFeEgGaA", conversion))
+			{
+				spec[specLength++] = conversion; spec[specLength] = '\0';
+				Append(out, outSize, length, spec, (double)value);
+			}
+			else
+			{
+				bool isUnsigned = strchr("uxXo", conversion) != nullptr;
+				spec[specLength++] = 'l'; spec[specLength++] = 'l';
+				spec[specLength++] = isUnsigned ? conversion : 'u'; spec[specLength] = '\0';
+				Append(out, outSize, length, spec, (unsigned long long)value);
+			}
+			break;
+		}
+		case LOG_ARG_DOUBLE:
+		{
+			double value = 0.0;
+			reader.Read(&value, sizeof(value));
+			spec[specLength++] = strchr("fFeEgGaA", conversion) ? conversion : 'g'; spec[specLength] = '\0';
+			Append(out, outSize, length, spec, value);
+			break;
+		}
+		case LOG_ARG_POINTER:
+		{
+			uint64_t value = 0;
+			reader.Read(&value, sizeof(value));
+			Append(out, outSize, length, "0x%llx", (unsigned long long)value);
+			break;
+		}
+		case LOG_ARG_STRING:
+		{
+			uint16_t stringLength = 0;
+			reader.Read(&stringLength, sizeof(stringLength));
+			if (reader.offset + stringLength > reader.size) stringLength = (uint16_t)(reader.size - reader.offset);
+
+			// Strings aren't null-terminated in the payload
+			char text[LOG_FORMAT_MAX_STRING];
+			size_t copy = (stringLength < sizeof(text) - 1) ? stringLength : sizeof(text) - 1;
+			memcpy(text, reader.data + reader.offset, copy);
+			text[copy] = '\0';
+
+			spec[specLength++] = 's'; spec[specLength] = '\0';
+			Append(out, outSize, length, spec, text);
+			reader.offset += stringLength;
+			break;
+		}
+		default:
+			Append(out, outSize, length, "<bad argument>");
+			return (int)length;
+		}
+	}
+
+	return (int)length;
+}
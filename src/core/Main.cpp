@@ -1,9 +1,11 @@
 #include "core/Application.h"
 #include "core/Globals.h"
+#include "core/Trace.h"
 
 #include "raylib.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 enum main_states
 {
@@ -14,10 +16,106 @@ enum main_states
 	MAIN_EXIT
 };
 
+// Command line options:
+//   --headless     simulate the race without window, audio or rendering
+//   --steps N      headless only: stop after N simulation steps
+//   --trace FILE   write a chrome://tracing JSON of the last seconds to FILE on exit
+//   --threads N    job system worker threads (0 = run everything on the main thread)
+//   --log-file F   also write every log message to F in binary form (read it with logdecode)
+//   --seed N       random seed for the race (default: from the clock)
+//   --record FILE  record the player's input (and the seed) to FILE
+//   --replay FILE  drive the player from a recording instead of the keyboard
+//   --hash-log F   write the simulation state hash of every step to F
+//   --hash-check F compare every step's state hash with a --hash-log file, report the first mismatch
+//   --pacing MODE  frame pacing: vsync (default), jit (just-in-time input) or uncapped (no vsync)
+//   --fps-cap N    most frames per second, 0 = no cap (default 60)
+//   --quality Q    optional work: auto (default, follows the frame budget), lowest, low, medium or high
+//   --time-scale N fast-forward: simulate N seconds per real second, 1 (default) to 16
+static void ParseCommandLine(int argc, char** argv, AppConfig& config)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--headless") == 0)
+		{
+			config.headless = true;
+		}
+		else if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc)
+		{
+			config.maxSteps = strtoull(argv[++i], NULL, 10);
+		}
+		else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+		{
+			config.tracePath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+		{
+			config.workerThreads = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--log-file") == 0 && i + 1 < argc)
+		{
+			log_open_binary(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+		{
+			config.randomSeed = (uint32)strtoul(argv[++i], NULL, 10);
+		}
+		else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+		{
+			config.recordPath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+		{
+			config.replayPath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--hash-log") == 0 && i + 1 < argc)
+		{
+			config.hashLogPath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--hash-check") == 0 && i + 1 < argc)
+		{
+			config.hashCheckPath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--pacing") == 0 && i + 1 < argc)
+		{
+			const char* mode = argv[++i];
+			if (strcmp(mode, "vsync") == 0) config.framePacing = FRAME_PACING_VSYNC;
+			else if (strcmp(mode, "jit") == 0) config.framePacing = FRAME_PACING_JUST_IN_TIME;
+			else if (strcmp(mode, "uncapped") == 0) config.framePacing = FRAME_PACING_UNCAPPED;
+			else LOG_WARN("Unknown frame pacing '%s'", mode);
+		}
+		else if (strcmp(argv[i], "--fps-cap") == 0 && i + 1 < argc)
+		{
+			config.frameCap = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--quality") == 0 && i + 1 < argc)
+		{
+			const char* quality = argv[++i];
+			if (strcmp(quality, "auto") == 0) config.quality = QUALITY_LEVEL_COUNT;
+			else if (strcmp(quality, "lowest") == 0) config.quality = QUALITY_LOWEST;
+			else if (strcmp(quality, "low") == 0) config.quality = QUALITY_LOW;
+			else if (strcmp(quality, "medium") == 0) config.quality = QUALITY_MEDIUM;
+			else if (strcmp(quality, "high") == 0) config.quality = QUALITY_HIGH;
+			else LOG_WARN("Unknown quality '%s'", quality);
+		}
+		else if (strcmp(argv[i], "--time-scale") == 0 && i + 1 < argc)
+		{
+			config.timeScale = atoi(argv[++i]);
+		}
+		else
+		{
+			LOG_WARN("Unknown command line option '%s'", argv[i]);
+		}
+	}
+}
+
 int main(int argc, char ** argv)
 {
+	trace_set_thread_name("Main");
 	LOG("Starting game '%s'...", TITLE);
 
+	AppConfig config;
+	ParseCommandLine(argc, argv, config);
+
 	int main_return = EXIT_FAILURE;
 	main_states state = MAIN_CREATION;
 	Application* App = NULL;
@@ -29,7 +127,7 @@ int main(int argc, char ** argv)
 		case MAIN_CREATION:
 
 			LOG("-------------- Application Creation --------------");
-			App = new Application();
+			App = new Application(config);
 			state = MAIN_START;
 			break;
 
@@ -83,5 +181,6 @@ int main(int argc, char ** argv)
 
 	delete App;
 	LOG("Exiting game '%s'...\n", TITLE);
+	log_shutdown();
 	return main_return;
 }
\ No newline at end of file
@@ -1,14 +1,23 @@
 ﻿#include "core/Map.h"
 #include "core/Application.h"
+#include "core/TrackCache.h"
 #include "core/Globals.h"
 #include "modules/ModuleResources.h"
 #include "modules/ModuleRender.h"
 #include "modules/ModulePhysics.h"
+#include "core/Trace.h"
 #include <sstream>
 #include <fstream>
 #include <algorithm>
 
-Map::Map(Application* app, bool start_enabled) : Module(app, start_enabled), mapLoaded(false)
+// The race track
+#define MAP_PATH "assets/map/"
+#define MAP_FILE_NAME "Map.tmx"
+
+// What GetMapData returns while no track is shown
+static const MapData emptyMapData = {};
+
+Map::Map(Application* app, bool start_enabled) : Module(app, start_enabled), track(nullptr)
 {
 }
 
@@ -16,6 +25,11 @@ Map::~Map()
 {
 }
 
+void Map::DeclareAccess()
+{
+    Writes({});
+}
+
 bool Map::Init()
 {
     LOG("Initializing Map Module");
@@ -25,24 +39,42 @@ bool Map::Init()
 bool Map::Start()
 {
     LOG("Starting Map Module");
-    
-    // If map is already loaded, skip re-loading to prevent duplicates
-    // The map data persists through Enable/Disable cycles once loaded
-    if (mapLoaded)
+
+    // Parsed once, then served by the application's track cache on every later race
+    CachedTrack* cached = App->tracks->Find(MAP_PATH, MAP_FILE_NAME);
+    if (cached)
     {
-        LOG("Map already loaded - skipping reload");
-        return true;
+        LOG("Map %s%s served from the track cache", MAP_PATH, MAP_FILE_NAME);
+        mapPath = cached->path;
+        mapFileName = cached->fileName;
     }
-    
-    bool ret = Load("assets/map/", "Map.tmx");
-
-    if (ret)
+    else
     {
-        // Create collision bodies for map objects
-        CreateCollisionBodies();
+        cached = new CachedTrack();
+        cached->path = MAP_PATH;
+        cached->fileName = MAP_FILE_NAME;
+        if (!Load(cached->path, cached->fileName, cached->data))
+        {
+            TrackCache::FreeMapData(cached->data, App->resources);
+            delete cached;
+            return false;
+        }
+        BuildColliders(*cached);
+        App->tracks->Insert(cached);
     }
 
-    return ret;
+    track = cached;
+    App->tracks->Acquire(track);
+
+    // The physics world is rebuilt for every race, so its bodies are too
+    CreateCollisionBodies();
+
+    return true;
+}
+
+const MapData& Map::GetMapData() const
+{
+    return track ? track->data : emptyMapData;
 }
 
 update_status Map::Update()
@@ -59,6 +91,7 @@ update_status Map::PostUpdate()
 
 TileSet* Map::GetTilesetFromTileId(int gid) const
 {
+    const MapData& mapData = GetMapData();
     TileSet* set = nullptr;
     for (const auto& tileset : mapData.tilesets)
     {
@@ -75,157 +108,18 @@ bool Map::CleanUp()
 {
     LOG("Cleaning up Map Module");
 
-    // Unload textures through resource manager
-    for (const auto& tileset : mapData.tilesets)
-    {
-        if (!tileset->imagePath.empty())
-        {
-            App->resources->UnloadTexture(tileset->imagePath.c_str());
-        }
-        delete tileset;
-    }
-    mapData.tilesets.clear();
-
-    for (const auto& layer : mapData.layers)
-    {
-        delete layer;
-    }
-    mapData.layers.clear();
-
-    for (const auto& imageLayer : mapData.imageLayers)
-    {
-        if (!imageLayer->imagePath.empty())
-        {
-            App->resources->UnloadTexture(imageLayer->imagePath.c_str());
-        }
-        delete imageLayer;
-    }
-    mapData.imageLayers.clear();
-
-    for (const auto& object : mapData.objects)
-    {
-        delete object;
-    }
-    mapData.objects.clear();
+    // The track stays in the cache (with its textures) for the next race - only
+    // TrackCache::Evict frees it. Its bodies went away with the physics world
+    App->tracks->Release(track);
+    track = nullptr;
 
-    mapLoaded = false;
     return true;
 }
 
-// Create physics bodies for collision objects
-bool Map::TriangulatePolygon(const std::vector<vec2i>& polygon, std::vector<std::vector<float>>& triangles)
-{
-	if (polygon.size() < 3)
-		return false;
-
-	// Use ear clipping algorithm for proper triangulation of concave polygons
-	std::vector<vec2i> vertices = polygon;
-	triangles.clear();
-
-	while (vertices.size() > 3)
-	{
-		bool foundEar = false;
-		
-		for (size_t i = 0; i < vertices.size(); ++i)
-		{
-			size_t prev = (i + vertices.size() - 1) % vertices.size();
-			size_t next = (i + 1) % vertices.size();
-			
-			// Check if this vertex forms an ear
-			if (IsEar(vertices, prev, i, next))
-			{
-				// Create triangle from prev, current, next
-				std::vector<float> triangle;
-				triangle.push_back(vertices[prev].x);
-				triangle.push_back(vertices[prev].y);
-				triangle.push_back(vertices[i].x);
-				triangle.push_back(vertices[i].y);
-				triangle.push_back(vertices[next].x);
-				triangle.push_back(vertices[next].y);
-				
-				triangles.push_back(triangle);
-				
-				// Remove the ear vertex
-				vertices.erase(vertices.begin() + i);
-				foundEar = true;
-				break;
-			}
-		}
-		
-		if (!foundEar)
-		{
-			// If no ear found, the polygon might be degenerate
-			// Fall back to a simple approach
-			break;
-		}
-	}
-	
-	// Add the final triangle
-	if (vertices.size() == 3)
-	{
-		std::vector<float> triangle;
-		triangle.push_back(vertices[0].x);
-		triangle.push_back(vertices[0].y);
-		triangle.push_back(vertices[1].x);
-		triangle.push_back(vertices[1].y);
-		triangle.push_back(vertices[2].x);
-		triangle.push_back(vertices[2].y);
-		
-		triangles.push_back(triangle);
-	}
-	
-	return !triangles.empty();
-}
-
-bool Map::IsEar(const std::vector<vec2i>& vertices, size_t prev, size_t current, size_t next)
-{
-	// Check if the triangle (prev, current, next) contains any other vertices
-	vec2i a = vertices[prev];
-	vec2i b = vertices[current];
-	vec2i c = vertices[next];
-	
-	// Check if triangle is counter-clockwise (convex)
-	if (CrossProduct(b - a, c - b) <= 0)
-		return false;
-	
-	// Check if any other vertex is inside this triangle
-	for (size_t i = 0; i < vertices.size(); ++i)
-	{
-		if (i == prev || i == current || i == next)
-			continue;
-		
-		if (PointInTriangle(vertices[i], a, b, c))
-			return false;
-	}
-	
-	return true;
-}
-
-float Map::CrossProduct(vec2i v1, vec2i v2)
-{
-	return v1.x * v2.y - v1.y * v2.x;
-}
-
-bool Map::PointInTriangle(vec2i p, vec2i a, vec2i b, vec2i c)
+// Collision geometry for map objects, computed once per parsed track
+void Map::BuildColliders(CachedTrack& cached) const
 {
-	// Use barycentric coordinate system to check if point is inside triangle
-	float area = CrossProduct(b - a, c - a);
-	float area1 = CrossProduct(p - a, b - a);
-	float area2 = CrossProduct(p - b, c - b);
-	float area3 = CrossProduct(p - c, a - c);
-	
-	// Check if all areas have the same sign as the total area
-	return (area1 >= 0 && area2 >= 0 && area3 >= 0 && area > 0) ||
-		   (area1 <= 0 && area2 <= 0 && area3 <= 0 && area < 0);
-}
-
-void Map::CreateCollisionBodies()
-{
-    if (!App->physics)
-    {
-        LOG("Warning: Physics module not available for collision creation");
-        return;
-    }
+    const MapData& mapData = cached.data;
 
     // Check for tile layer named "Collisions" and create collision bodies for each tile
     for (const auto& layer : mapData.layers)
@@ -247,20 +141,13 @@ void Map::CreateCollisionBodies()
                         float tileY = y * mapData.tileHeight;
 
                         // Box2D usually wants the center of the rectangle, so add half the size
-                        float centerX = tileX + (mapData.tileWidth / 2.0f);
-                        float centerY = tileY + (mapData.tileHeight / 2.0f);
-
-                        // Create static body
-                        PhysBody* body = App->physics->CreateRectangle(centerX, centerY, mapData.tileWidth, mapData.tileHeight, PhysBody::BodyType::STATIC);
-                        if (body)
-                        {
-                            LOG("Created tile collision body at (%.1f, %.1f) size (%.1f, %.1f)",
-                                centerX, centerY, (float)mapData.tileWidth, (float)mapData.tileHeight);
-                        }
-                        else
-                        {
-                            LOG("Failed to create tile collision body at (%d, %d)", x, y);
-                        }
+                        TrackCollider collider = {};
+                        collider.shape = TrackCollider::RECTANGLE;
+                        collider.x = tileX + (mapData.tileWidth / 2.0f);
+                        collider.y = tileY + (mapData.tileHeight / 2.0f);
+                        collider.width = (float)mapData.tileWidth;
+                        collider.height = (float)mapData.tileHeight;
+                        cached.colliders.push_back(collider);
                     }
                 }
             }
@@ -280,51 +167,77 @@ void Map::CreateCollisionBodies()
         // If we create physics for them, the car will collide against water/mud like a solid wall.
         if (object->type == "Normal" || object->type == "Water" || object->type == "Mud")
         {
-            // LOG("Zone object '%s' (%s) skipped for physics creation (handled by logic)", object->name.c_str(), object->type.c_str());
             continue; 
         }
 
         // 3. Create walls (Only Polylines/Chains that are not zones)
         if (object->hasPolygon && !object->polygonPoints.empty())
         {
-            std::vector<float> worldVertices;
+            TrackCollider collider = {};
+            collider.shape = TrackCollider::CHAIN;
+            collider.closed = object->isClosed;
+            collider.object = object;
             for (const auto& point : object->polygonPoints)
             {
-                worldVertices.push_back((float)object->x + point.x);
-                worldVertices.push_back((float)object->y + point.y);
-            }
-
-            // Create the physical chain (Polylines have isClosed = false -> Will use the two-sided edges fix)
-            PhysBody* body = App->physics->CreateChain(0, 0, worldVertices.data(), worldVertices.size() / 2, object->isClosed);
-
-            if (body)
-            {
-                body->SetUserData((void*)object);
-                LOG("Created Wall/Collision body for object '%s' (Points: %d)", object->name.c_str(), (int)object->polygonPoints.size());
+                collider.vertices.push_back((float)object->x + point.x);
+                collider.vertices.push_back((float)object->y + point.y);
             }
+            cached.colliders.push_back(collider);
         }
         else if (object->width > 0 && object->height > 0)
         {
-            // Create rectangle collision body for objects without polygons
+            // Rectangle collision body for objects without polygons
             // Position is center of rectangle
-            float centerX = object->x + object->width * 0.5f;
-            float centerY = object->y + object->height * 0.5f;
+            TrackCollider collider = {};
+            collider.shape = TrackCollider::RECTANGLE;
+            collider.x = object->x + object->width * 0.5f;
+            collider.y = object->y + object->height * 0.5f;
+            collider.width = (float)object->width;
+            collider.height = (float)object->height;
+            collider.object = object;
+            cached.colliders.push_back(collider);
+        }
+    }
+}
 
-            PhysBody* body = App->physics->CreateRectangle(centerX, centerY, object->width, object->height, PhysBody::BodyType::STATIC);
-            if (body)
-            {
-                // Store reference to the map object for terrain type detection
-                body->SetUserData((void*)object);
+// Create physics bodies for collision objects
+void Map::CreateCollisionBodies()
+{
+    TRACE_ZONE("Map::CreateCollisionBodies");
 
-                LOG("Created rectangle collision body for object '%s' at (%.1f, %.1f) size (%.1f, %.1f)",
-                    object->name.c_str(), centerX, centerY, object->width, object->height);
-            }
-            else
-            {
-                LOG("Failed to create rectangle collision body for object '%s'", object->name.c_str());
-            }
+    if (!App->physics)
+    {
+        LOG("Warning: Physics module not available for collision creation");
+        return;
+    }
+
+    int created = 0;
+    for (const TrackCollider& collider : track->colliders)
+    {
+        PhysBody* body = nullptr;
+        if (collider.shape == TrackCollider::CHAIN)
+        {
+            // Polylines have closed = false -> Will use the two-sided edges fix
+            body = App->physics->CreateChain(0, 0, collider.vertices.data(), (int)collider.vertices.size() / 2, collider.closed);
+        }
+        else
+        {
+            body = App->physics->CreateRectangle(collider.x, collider.y, collider.width, collider.height, PhysBody::BodyType::STATIC);
+        }
+
+        if (body)
+        {
+            // Store reference to the map object for terrain type detection
+            if (collider.object) body->SetUserData((void*)collider.object);
+            created++;
+        }
+        else
+        {
+            LOG("Failed to create collision body for object '%s'", collider.object ? collider.object->name.c_str() : "Collisions tile");
         }
     }
+
+    LOG("Created %d map collision bodies", created);
 }
 
 // Simple XML parser helper functions
@@ -359,8 +272,10 @@ static std::string Trim(const std::string& str)
     return str.substr(first, (last - first + 1));
 }
 
-bool Map::Load(const std::string& path, const std::string& fileName)
+bool Map::Load(const std::string& path, const std::string& fileName, MapData& mapData)
 {
+	TRACE_ZONE("Map::Load");
+
 	bool ret = false;
 	mapFileName = fileName;
 	mapPath = path;
@@ -371,7 +286,7 @@ bool Map::Load(const std::string& path, const std::string& fileName)
 	std::ifstream file(fullPath);
 	if (!file.is_open())
 	{
-		LOG("ERROR: Could not open map file: %s", fullPath.c_str());
+		LOG_ERR("Could not open map file: %s", fullPath.c_str());
 		return false;
 	}
 
@@ -645,7 +560,6 @@ bool Map::Load(const std::string& path, const std::string& fileName)
 	file.close();
 
 	ret = !mapData.layers.empty() || !mapData.imageLayers.empty() || !mapData.objects.empty();
-	mapLoaded = ret;
 
 	if (ret)
 	{
@@ -658,7 +572,7 @@ bool Map::Load(const std::string& path, const std::string& fileName)
 	}
 	else
 	{
-		LOG("ERROR: Failed to load map data from: %s", fileName.c_str());
+		LOG_ERR("Failed to load map data from: %s", fileName.c_str());
 	}
 
 	return ret;
@@ -666,6 +580,7 @@ bool Map::Load(const std::string& path, const std::string& fileName)
 
 vec2f Map::MapToWorld(int i, int j) const
 {
+    const MapData& mapData = GetMapData();
     vec2f ret;
     ret.x = (float)(j * mapData.tileWidth);
     ret.y = (float)(i * mapData.tileHeight);
@@ -674,6 +589,7 @@ vec2f Map::MapToWorld(int i, int j) const
 
 vec2i Map::WorldToMap(int x, int y) const
 {
+    const MapData& mapData = GetMapData();
     vec2i ret;
     ret.x = x / mapData.tileWidth;
     ret.y = y / mapData.tileHeight;
@@ -682,6 +598,7 @@ vec2i Map::WorldToMap(int x, int y) const
 
 MapObject* Map::GetObjectByName(const std::string& name) const
 {
+    const MapData& mapData = GetMapData();
     for (const auto& object : mapData.objects)
     {
         if (object->name == name)
@@ -695,9 +612,13 @@ MapObject* Map::GetObjectByName(const std::string& name) const
 
 void Map::RenderMap() const
 {
-    if (!mapLoaded)
+    TRACE_ZONE("Map::RenderMap");
+
+    if (!track)
         return;
 
+    const MapData& mapData = track->data;
+
     // Render all image layers
     for (const auto& imageLayer : mapData.imageLayers)
     {
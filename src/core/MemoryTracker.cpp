@@ -0,0 +1,139 @@
+#include "core/MemoryTracker.h"
+
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+
+static const char* const memoryTagNames[MEM_TAG_COUNT] = {
+	"untagged", "physics", "map", "entities", "resources", "render", "audio"
+};
+
+static thread_local MemoryTag currentTag = MEM_UNTAGGED;
+
+#ifndef MEMORY_TRACKING_DISABLED
+
+// Counters are constant-initialized, so they work for allocations made before main
+static std::atomic<uint64_t> allocCalls[MEM_TAG_COUNT];
+static std::atomic<uint64_t> allocBytes[MEM_TAG_COUNT];
+static std::atomic<int64_t> liveBytes[MEM_TAG_COUNT];
+
+// Every block starts with its size and tag, so delete knows what to give back.
+// 16 bytes keeps the returned pointer aligned like malloc's.
+struct alignas(16) AllocationHeader
+{
+	uint64_t size;
+	uint8_t tag;
+};
+static_assert(sizeof(AllocationHeader) == 16, "Allocation header must keep malloc alignment");
+
+static void* TrackedAlloc(size_t size)
+{
+	void* block = malloc(sizeof(AllocationHeader) + size);
+	if (block == nullptr) return nullptr;
+
+	MemoryTag tag = currentTag;
+	AllocationHeader* header = (AllocationHeader*)block;
+	header->size = size;
+	header->tag = tag;
+
+	allocCalls[tag].fetch_add(1, std::memory_order_relaxed);
+	allocBytes[tag].fetch_add(size, std::memory_order_relaxed);
+	liveBytes[tag].fetch_add((int64_t)size, std::memory_order_relaxed);
+	return header + 1;
+}
+
+static void* TrackedAllocOrThrow(size_t size)
+{
+	while (true)
+	{
+		void* memory = TrackedAlloc(size);
+		if (memory != nullptr) return memory;
+
+		std::new_handler handler = std::get_new_handler();
+		if (handler == nullptr) throw std::bad_alloc();
+		handler();
+	}
+}
+
+static void TrackedFree(void* memory)
+{
+	if (memory == nullptr) return;
+
+	AllocationHeader* header = (AllocationHeader*)memory - 1;
+	liveBytes[header->tag].fetch_sub((int64_t)header->size, std::memory_order_relaxed);
+	free(header);
+}
+
+void* operator new(size_t size) { return TrackedAllocOrThrow(size); }
+void* operator new[](size_t size) { return TrackedAllocOrThrow(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return TrackedAlloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return TrackedAlloc(size); }
+
+void operator delete(void* memory) noexcept { TrackedFree(memory); }
+void operator delete[](void* memory) noexcept { TrackedFree(memory); }
+void operator delete(void* memory, size_t) noexcept { TrackedFree(memory); }
+void operator delete[](void* memory, size_t) noexcept { TrackedFree(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { TrackedFree(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { TrackedFree(memory); }
+
+void memory_snapshot(MemoryCounters& counters)
+{
+	for (int tag = 0; tag < MEM_TAG_COUNT; ++tag)
+	{
+		counters.calls[tag] = allocCalls[tag].load(std::memory_order_relaxed);
+		counters.bytes[tag] = allocBytes[tag].load(std::memory_order_relaxed);
+		counters.live[tag] = liveBytes[tag].load(std::memory_order_relaxed);
+	}
+}
+
+#else
+
+void memory_snapshot(MemoryCounters& counters)
+{
+	counters = MemoryCounters();
+}
+
+#endif
+
+uint64_t MemoryCounters::TotalCalls() const
+{
+	uint64_t total = 0;
+	for (int tag = 0; tag < MEM_TAG_COUNT; ++tag) total += calls[tag];
+	return total;
+}
+
+uint64_t MemoryCounters::TotalBytes() const
+{
+	uint64_t total = 0;
+	for (int tag = 0; tag < MEM_TAG_COUNT; ++tag) total += bytes[tag];
+	return total;
+}
+
+MemoryTag memory_set_tag(MemoryTag tag)
+{
+	MemoryTag previous = currentTag;
+	currentTag = tag;
+	return previous;
+}
+
+MemoryTag memory_get_tag()
+{
+	return currentTag;
+}
+
+MemoryCounters memory_diff(const MemoryCounters& start, const MemoryCounters& end)
+{
+	MemoryCounters diff;
+	for (int tag = 0; tag < MEM_TAG_COUNT; ++tag)
+	{
+		diff.calls[tag] = end.calls[tag] - start.calls[tag];
+		diff.bytes[tag] = end.bytes[tag] - start.bytes[tag];
+		diff.live[tag] = end.live[tag];
+	}
+	return diff;
+}
+
+const char* memory_tag_name(MemoryTag tag)
+{
+	return (tag < MEM_TAG_COUNT) ? memoryTagNames[tag] : "?";
+}
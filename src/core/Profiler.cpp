@@ -0,0 +1,146 @@
+#include "core/Profiler.h"
+
+#include <algorithm>
+
+static const ProfileStats emptyStats;
+
+Profiler::Profiler() : framesSinceRefresh(0)
+{
+}
+
+int Profiler::AddSlot(const char* name)
+{
+	Slot slot;
+	slot.name = name;
+	for (int p = 0; p < PHASE_COUNT; ++p)
+	{
+		slot.current[p] = 0.0;
+		slot.ran[p] = false;
+	}
+	slots.push_back(slot);
+	return (int)slots.size() - 1;
+}
+
+void Profiler::BeginFrame()
+{
+	for (Slot& slot : slots)
+	{
+		for (int p = 0; p < PHASE_COUNT; ++p)
+		{
+			slot.current[p] = 0.0;
+			slot.ran[p] = false;
+		}
+	}
+}
+
+void Profiler::Record(int slot, ProfilePhase phase, double ms)
+{
+	if (slot < 0 || slot >= (int)slots.size())
+		return;
+
+	slots[slot].current[phase] += ms;
+	slots[slot].ran[phase] = true;
+}
+
+void Profiler::EndFrame(double frameMs)
+{
+	double totals[PHASE_COUNT] = { 0.0 };
+	bool phaseRan[PHASE_COUNT] = { false };
+
+	// Only modules that actually ran contribute a sample - a disabled module
+	// would otherwise drag its min/avg down to zero
+	for (Slot& slot : slots)
+	{
+		for (int p = 0; p < PHASE_COUNT; ++p)
+		{
+			if (!slot.ran[p]) continue;
+			slot.phases[p].Push((float)slot.current[p]);
+			totals[p] += slot.current[p];
+			phaseRan[p] = true;
+		}
+	}
+
+	for (int p = 0; p < PHASE_COUNT; ++p)
+	{
+		if (phaseRan[p]) phaseTotals[p].Push((float)totals[p]);
+	}
+	frame.Push((float)frameMs);
+
+	// Sorting for p99 is cheap but pointless every frame
+	if (++framesSinceRefresh >= PROFILER_REFRESH_FRAMES)
+	{
+		framesSinceRefresh = 0;
+		for (Slot& slot : slots)
+		{
+			for (int p = 0; p < PHASE_COUNT; ++p) slot.phases[p].ComputeStats();
+		}
+		for (int p = 0; p < PHASE_COUNT; ++p) phaseTotals[p].ComputeStats();
+		frame.ComputeStats();
+	}
+}
+
+const char* Profiler::GetSlotName(int slot) const
+{
+	if (slot < 0 || slot >= (int)slots.size())
+		return "";
+	return slots[slot].name;
+}
+
+const ProfileStats& Profiler::GetStats(int slot, ProfilePhase phase) const
+{
+	if (slot < 0 || slot >= (int)slots.size() || phase >= PHASE_COUNT)
+		return emptyStats;
+	return slots[slot].phases[phase].stats;
+}
+
+const ProfileStats& Profiler::GetPhaseStats(ProfilePhase phase) const
+{
+	if (phase >= PHASE_COUNT)
+		return emptyStats;
+	return phaseTotals[phase].stats;
+}
+
+const char* Profiler::GetPhaseName(ProfilePhase phase)
+{
+	switch (phase)
+	{
+	case PHASE_PRE_UPDATE: return "PreUpdate";
+	case PHASE_FIXED_UPDATE: return "FixedUpdate";
+	case PHASE_UPDATE: return "Update";
+	case PHASE_POST_UPDATE: return "PostUpdate";
+	default: return "?";
+	}
+}
+
+// === HISTORY ===
+void Profiler::History::Push(float ms)
+{
+	samples[head] = ms;
+	head = (head + 1) % PROFILER_HISTORY;
+	if (count < PROFILER_HISTORY) count++;
+}
+
+void Profiler::History::ComputeStats()
+{
+	if (count == 0)
+	{
+		stats = ProfileStats();
+		return;
+	}
+
+	float sorted[PROFILER_HISTORY];
+	std::copy(samples, samples + count, sorted);
+	std::sort(sorted, sorted + count);
+
+	double sum = 0.0;
+	for (int i = 0; i < count; ++i) sum += sorted[i];
+
+	int p99Index = (int)(count * 0.99f);
+	if (p99Index >= count) p99Index = count - 1;
+
+	stats.minMs = sorted[0];
+	stats.maxMs = sorted[count - 1];
+	stats.avgMs = (float)(sum / count);
+	stats.p99Ms = sorted[p99Index];
+	stats.samples = count;
+}
@@ -0,0 +1,75 @@
+#include "core/QualityGovernor.h"
+
+static const char* const qualityLevelNames[QUALITY_LEVEL_COUNT] = { "lowest", "low", "medium", "high" };
+
+// mud, water, background, thick debug, velocity its, position its, diagonal ray interval
+static const QualitySettings qualityTable[QUALITY_LEVEL_COUNT] = {
+	{ 0, 0, false, false, 4, 2, 3 },  // lowest
+	{ 1, 1, false, false, 6, 2, 2 },  // low
+	{ 2, 1, true,  false, 6, 3, 1 },  // medium
+	{ 3, 2, true,  true,  8, 3, 1 },  // high - the original values
+};
+
+QualityGovernor::QualityGovernor()
+{
+	SetLevel(QUALITY_HIGH);
+}
+
+const char* QualityGovernor::GetLevelName(QualityLevel qualityLevel)
+{
+	return (qualityLevel < QUALITY_LEVEL_COUNT) ? qualityLevelNames[qualityLevel] : "?";
+}
+
+void QualityGovernor::SetFixedLevel(QualityLevel fixedLevel)
+{
+	adaptive = (fixedLevel >= QUALITY_LEVEL_COUNT);
+	SetLevel(adaptive ? QUALITY_HIGH : fixedLevel);
+}
+
+void QualityGovernor::SetSimulationLocked(bool locked)
+{
+	if (locked == simulationLocked)
+		return;
+
+	simulationLocked = locked;
+	SetLevel(level);
+}
+
+void QualityGovernor::Update(double workMs, double budgetMs)
+{
+	smoothedWorkMs += (workMs - smoothedWorkMs) * QUALITY_WORK_SMOOTHING;
+
+	if (!adaptive || budgetMs <= 0.0)
+		return;
+
+	double load = smoothedWorkMs / budgetMs;
+	framesOverBudget = (load > QUALITY_DOWNGRADE_LOAD) ? framesOverBudget + 1 : 0;
+	framesUnderBudget = (load < QUALITY_UPGRADE_LOAD) ? framesUnderBudget + 1 : 0;
+
+	if (framesOverBudget >= QUALITY_DOWNGRADE_FRAMES && level > QUALITY_LOWEST)
+	{
+		SetLevel((QualityLevel)(level - 1));
+		LOG("Quality down to %s (frame work %.1f ms, budget %.1f ms)", GetLevelName(level), smoothedWorkMs, budgetMs);
+	}
+	else if (framesUnderBudget >= QUALITY_UPGRADE_FRAMES && level < QUALITY_HIGH)
+	{
+		SetLevel((QualityLevel)(level + 1));
+		LOG("Quality up to %s (frame work %.1f ms, budget %.1f ms)", GetLevelName(level), smoothedWorkMs, budgetMs);
+	}
+}
+
+void QualityGovernor::SetLevel(QualityLevel newLevel)
+{
+	level = newLevel;
+	settings = qualityTable[level];
+	framesOverBudget = 0;
+	framesUnderBudget = 0;
+
+	if (simulationLocked)
+	{
+		const QualitySettings& full = qualityTable[QUALITY_HIGH];
+		settings.velocityIterations = full.velocityIterations;
+		settings.positionIterations = full.positionIterations;
+		settings.diagonalSensorInterval = full.diagonalSensorInterval;
+	}
+}
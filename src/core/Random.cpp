@@ -0,0 +1,58 @@
+#include "core/Random.h"
+
+// PCG-XSH-RR with the reference multiplier and increment (pcg-random.org)
+#define PCG_MULTIPLIER 6364136223846793005ULL
+#define PCG_INCREMENT 1442695040888963407ULL
+
+// Scrambles the stream id into the starting state (MurmurHash3 finalizer, 0 stays 0), so
+// streams of one seed start far apart instead of differing only in their increment
+static uint64_t MixStream(uint64_t stream)
+{
+	stream ^= stream >> 33;
+	stream *= 0xff51afd7ed558ccdULL;
+	stream ^= stream >> 33;
+	stream *= 0xc4ceb9fe1a85ec53ULL;
+	stream ^= stream >> 33;
+	return stream;
+}
+
+Random::Random(uint64_t seed, uint64_t stream)
+{
+	Seed(seed, stream);
+}
+
+void Random::Seed(uint64_t seed, uint64_t stream)
+{
+	// Any odd increment is a full-period stream; the reference one is stream 0
+	increment = PCG_INCREMENT + (stream << 1);
+
+	state = 0;
+	Next();
+	state += seed ^ MixStream(stream);
+	Next();
+}
+
+uint32_t Random::Next()
+{
+	uint64_t old = state;
+	state = old * PCG_MULTIPLIER + increment;
+
+	uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+	uint32_t rot = (uint32_t)(old >> 59u);
+	return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+}
+
+int Random::Range(int min, int max)
+{
+	if (max <= min) return min;
+
+	// Rejection sampling keeps the range unbiased
+	uint32_t span = (uint32_t)(max - min) + 1u;
+	if (span == 0) return (int)Next();
+
+	uint32_t limit = (uint32_t)(0u - span) % span;
+	uint32_t value = Next();
+	while (value < limit) value = Next();
+
+	return min + (int)(value % span);
+}
@@ -0,0 +1,208 @@
+#include "core/StateHash.h"
+
+#include <string.h>
+
+// XXH64 primes (github.com/Cyan4973/xxHash)
+#define XXH_PRIME64_1 0x9E3779B185EBCA87ULL
+#define XXH_PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define XXH_PRIME64_3 0x165667B19E3779F9ULL
+#define XXH_PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define XXH_PRIME64_5 0x27D4EB2F165667C5ULL
+
+static inline uint64_t Rotl64(uint64_t value, int bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+// Unaligned little-endian loads - snapshot buffers hold values at any offset
+static inline uint64_t Read64(const uint8_t* p)
+{
+	uint64_t value;
+	memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+static inline uint32_t Read32(const uint8_t* p)
+{
+	uint32_t value;
+	memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+static inline uint64_t Round(uint64_t acc, uint64_t input)
+{
+	acc += input * XXH_PRIME64_2;
+	acc = Rotl64(acc, 31);
+	return acc * XXH_PRIME64_1;
+}
+
+static inline uint64_t MergeRound(uint64_t acc, uint64_t value)
+{
+	acc ^= Round(0, value);
+	return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+
+uint64_t xxh64(const void* data, size_t size, uint64_t seed)
+{
+	const uint8_t* p = (const uint8_t*)data;
+	const uint8_t* end = p + size;
+	uint64_t hash;
+
+	if (size >= 32)
+	{
+		// Four independent lanes over 32-byte stripes
+		uint64_t v1 = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+		uint64_t v2 = seed + XXH_PRIME64_2;
+		uint64_t v3 = seed;
+		uint64_t v4 = seed - XXH_PRIME64_1;
+
+		const uint8_t* limit = end - 32;
+		do
+		{
+			v1 = Round(v1, Read64(p)); p += 8;
+			v2 = Round(v2, Read64(p)); p += 8;
+			v3 = Round(v3, Read64(p)); p += 8;
+			v4 = Round(v4, Read64(p)); p += 8;
+		} while (p <= limit);
+
+		hash = Rotl64(v1, 1) + Rotl64(v2, 7) + Rotl64(v3, 12) + Rotl64(v4, 18);
+		hash = MergeRound(hash, v1);
+		hash = MergeRound(hash, v2);
+		hash = MergeRound(hash, v3);
+		hash = MergeRound(hash, v4);
+	}
+	else
+	{
+		hash = seed + XXH_PRIME64_5;
+	}
+
+	hash += (uint64_t)size;
+
+	// Tail: 8, then 4, then single bytes
+	while (p + 8 <= end)
+	{
+		hash ^= Round(0, Read64(p));
+		hash = Rotl64(hash, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+		p += 8;
+	}
+	if (p + 4 <= end)
+	{
+		hash ^= (uint64_t)Read32(p) * XXH_PRIME64_1;
+		hash = Rotl64(hash, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+		p += 4;
+	}
+	while (p < end)
+	{
+		hash ^= (*p) * XXH_PRIME64_5;
+		hash = Rotl64(hash, 11) * XXH_PRIME64_1;
+		p++;
+	}
+
+	// Avalanche
+	hash ^= hash >> 33;
+	hash *= XXH_PRIME64_2;
+	hash ^= hash >> 29;
+	hash *= XXH_PRIME64_3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+// === HASH LOG ===
+StateHashLog::~StateHashLog()
+{
+	Close();
+}
+
+bool StateHashLog::OpenWrite(const char* path)
+{
+	Close();
+
+	file = fopen(path, "w");
+	if (file == nullptr)
+	{
+		LOG_ERR("Could not open state hash log '%s'", path);
+		return false;
+	}
+
+	checking = false;
+	LOG("Writing state hashes to '%s'", path);
+	return true;
+}
+
+bool StateHashLog::OpenCheck(const char* path)
+{
+	Close();
+
+	file = fopen(path, "r");
+	if (file == nullptr)
+	{
+		LOG_ERR("Could not open state hash log '%s'", path);
+		return false;
+	}
+
+	checking = true;
+	exhausted = false;
+	diverged = false;
+	divergedStep = 0;
+	checkedSteps = 0;
+	LOG("Checking state hashes against '%s'", path);
+	return true;
+}
+
+void StateHashLog::Close()
+{
+	if (file == nullptr)
+		return;
+
+	if (checking)
+	{
+		if (diverged)
+		{
+			LOG_ERR("State hash check: diverged at step %llu", (unsigned long long)divergedStep);
+		}
+		else
+		{
+			LOG("State hash check: %llu steps matched", (unsigned long long)checkedSteps);
+		}
+	}
+
+	fclose(file);
+	file = nullptr;
+}
+
+bool StateHashLog::Step(uint64 step, uint64_t hash)
+{
+	if (file == nullptr)
+		return true;
+
+	if (!checking)
+	{
+		fprintf(file, "%llu %016llx\n", (unsigned long long)step, (unsigned long long)hash);
+		return true;
+	}
+
+	if (diverged)
+		return false;
+	if (exhausted)
+		return true;
+
+	unsigned long long expectedStep = 0, expectedHash = 0;
+	if (fscanf(file, "%llu %llx", &expectedStep, &expectedHash) != 2)
+	{
+		exhausted = true;
+		LOG("State hash check: log ends at step %llu", (unsigned long long)step);
+		return true;
+	}
+
+	if (expectedStep != step || expectedHash != hash)
+	{
+		diverged = true;
+		divergedStep = step;
+		LOG_ERR("State hash mismatch at step %llu: %016llx, expected %016llx at step %llu", (unsigned long long)step,
+			(unsigned long long)hash, expectedHash, expectedStep);
+		return false;
+	}
+
+	checkedSteps++;
+	return true;
+}
@@ -1,9 +1,126 @@
-// Simple timer class for measuring elapsed time
+// Monotonic clock, stopwatch and scoped time accumulators
+// Built on the C++ steady clock (or the TSC) rather than raylib's GetTime(), which needs
+// a window - so timers also work headless, in tools and on any thread
 
 #include "core/Timer.h"
+#include "core/Log.h"
 
-#include "raylib.h"
+#include <chrono>
+#include <mutex>
+#include <stdio.h>
+#include <string.h>
 
+#if defined(__linux__) && (defined(__x86_64__) || defined(__i386__))
+#define CLOCK_HAS_TSC
+#include <x86intrin.h>
+#endif
+
+struct ClockState
+{
+	bool useTsc = false;
+	double nsPerTick = 1.0;
+	uint64_t epoch = 0;     // ticks at first use
+};
+
+static uint64_t SteadyNs()
+{
+	return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#ifdef CLOCK_HAS_TSC
+// The kernel only keeps time with the TSC once it has checked it is invariant and in step
+// on every core - its verdict is better than anything we could test in a few milliseconds
+static bool KernelTrustsTsc()
+{
+	FILE* file = fopen("/sys/devices/system/clocksource/clocksource0/current_clocksource", "r");
+	if (file == nullptr)
+		return false;
+
+	char source[32] = {};
+	bool tsc = fgets(source, sizeof(source), file) != nullptr && strncmp(source, "tsc", 3) == 0;
+	fclose(file);
+	return tsc;
+}
+#endif
+
+static uint64_t RawTicks(bool useTsc)
+{
+#ifdef CLOCK_HAS_TSC
+	if (useTsc) return __rdtsc();
+#endif
+	return SteadyNs();
+}
+
+// Runs once, on the first clock use. Must not log: the logger timestamps with this clock
+static ClockState InitClock()
+{
+	ClockState state;
+
+#ifdef CLOCK_HAS_TSC
+	if (KernelTrustsTsc())
+	{
+		// Count TSC ticks over a short spin of the monotonic clock
+		uint64_t ns0 = SteadyNs();
+		uint64_t tsc0 = __rdtsc();
+		uint64_t ns1, tsc1;
+		do
+		{
+			ns1 = SteadyNs();
+			tsc1 = __rdtsc();
+		} while (ns1 - ns0 < (uint64_t)(CLOCK_TSC_CALIBRATION_MS * 1000000.0));
+
+		if (tsc1 > tsc0)
+		{
+			state.useTsc = true;
+			state.nsPerTick = (double)(ns1 - ns0) / (double)(tsc1 - tsc0);
+		}
+	}
+#endif
+
+	state.epoch = RawTicks(state.useTsc);
+	return state;
+}
+
+static const ClockState& GetClock()
+{
+	static const ClockState state = InitClock();
+	return state;
+}
+
+// === CLOCK ===
+uint64_t clock_ticks()
+{
+	return RawTicks(GetClock().useTsc);
+}
+
+uint64_t clock_ticks_to_ns(uint64_t ticks)
+{
+	const ClockState& state = GetClock();
+	return state.useTsc ? (uint64_t)(ticks * state.nsPerTick) : ticks;
+}
+
+double clock_ticks_to_sec(uint64_t ticks)
+{
+	return ticks * GetClock().nsPerTick * 1e-9;
+}
+
+uint64_t clock_now_ns()
+{
+	const ClockState& state = GetClock();
+	return clock_ticks_to_ns(RawTicks(state.useTsc) - state.epoch);
+}
+
+const char* clock_source_name()
+{
+	return GetClock().useTsc ? "tsc" : "steady_clock";
+}
+
+double clock_ticks_per_sec()
+{
+	return 1e9 / GetClock().nsPerTick;
+}
+
+// === TIMER ===
 Timer::Timer()
 {
 	Start();
@@ -11,10 +128,84 @@ Timer::Timer()
 
 void Timer::Start()
 {
-	started_at = GetTime();
+	started_at = clock_ticks();
+}
+
+uint64_t Timer::ReadTicks() const
+{
+	return clock_ticks() - started_at;
 }
 
 double Timer::ReadSec() const
 {
-	return (GetTime() - started_at);
-}
\ No newline at end of file
+	return clock_ticks_to_sec(ReadTicks());
+}
+
+double Timer::ReadMs() const
+{
+	return clock_ticks_to_sec(ReadTicks()) * 1000.0;
+}
+
+double Timer::ReadUs() const
+{
+	return clock_ticks_to_sec(ReadTicks()) * 1000000.0;
+}
+
+// === ACCUMULATORS ===
+// Accumulators are statics that live until exit, the registry only keeps pointers
+static std::mutex accumulatorMutex;
+static TimeAccumulator* accumulators[MAX_TIME_ACCUMULATORS];
+static std::atomic<int> accumulatorCount(0);
+
+TimeAccumulator::TimeAccumulator(const char* accumulatorName) : name(accumulatorName)
+{
+	std::lock_guard<std::mutex> lock(accumulatorMutex);
+	int count = accumulatorCount.load(std::memory_order_relaxed);
+	if (count < MAX_TIME_ACCUMULATORS)
+	{
+		accumulators[count] = this;
+		accumulatorCount.store(count + 1, std::memory_order_release);
+	}
+}
+
+void TimeAccumulator::Reset()
+{
+	ticks.store(0, std::memory_order_relaxed);
+	calls.store(0, std::memory_order_relaxed);
+}
+
+int time_accumulator_count()
+{
+	return accumulatorCount.load(std::memory_order_acquire);
+}
+
+const TimeAccumulator* time_accumulator_get(int index)
+{
+	return (index >= 0 && index < time_accumulator_count()) ? accumulators[index] : nullptr;
+}
+
+void time_accumulators_reset()
+{
+	int count = time_accumulator_count();
+	for (int i = 0; i < count; ++i)
+	{
+		accumulators[i]->Reset();
+	}
+}
+
+void time_accumulators_log()
+{
+	int count = time_accumulator_count();
+	if (count == 0)
+		return;
+
+	LOG("Scoped timers (clock: %s, %.0f ticks/us):", clock_source_name(), clock_ticks_per_sec() * 1e-6);
+	for (int i = 0; i < count; ++i)
+	{
+		const TimeAccumulator* accumulator = accumulators[i];
+		uint64_t calls = accumulator->GetCalls();
+		double totalMs = accumulator->GetTotalMs();
+		LOG("  %-24s %10llu calls %10.2f ms total %8.3f us avg", accumulator->GetName(), (unsigned long long)calls,
+			totalMs, calls > 0 ? totalMs * 1000.0 / calls : 0.0);
+	}
+}
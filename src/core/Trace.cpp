@@ -0,0 +1,195 @@
+#include "core/Trace.h"
+#include "core/Timer.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+// One finished zone ('X' complete event in the trace format)
+struct TraceEvent
+{
+	const char* name;
+	const char* category;
+	int64_t startNs;
+	int64_t durationNs;
+};
+
+// Ring slot. A dump may copy it while the owner overwrites it, so the fields are
+// relaxed atomics - a torn copy is detected and dropped, see trace_dump
+struct TraceSlot
+{
+	std::atomic<const char*> name{ nullptr };
+	std::atomic<const char*> category{ nullptr };
+	std::atomic<int64_t> startNs{ 0 };
+	std::atomic<int64_t> durationNs{ 0 };
+};
+
+struct TraceOpenZone
+{
+	const char* name;
+	const char* category;
+	int64_t startNs;
+};
+
+// Per-thread ring - only its owner thread writes, so recording needs no lock
+// Works like a seqlock: event 'written' goes into slot written % TRACE_BUFFER_EVENTS
+// and 'written' is bumped once it is complete. A dump re-reads 'written' after
+// copying a slot to tell whether the owner started overwriting it meanwhile
+struct TraceThreadBuffer
+{
+	TraceSlot events[TRACE_BUFFER_EVENTS];
+	std::atomic<uint64_t> written{ 0 };
+
+	TraceOpenZone open[TRACE_MAX_DEPTH];
+	int depth = 0;
+
+	// Set and read under bufferMutex
+	int threadId = 0;
+	const char* threadName = nullptr;
+};
+
+// Buffers are never freed, a thread that exited still shows up in the next dump
+static std::mutex bufferMutex;
+static std::vector<TraceThreadBuffer*> buffers;
+static thread_local TraceThreadBuffer* threadBuffer = nullptr;
+
+static int64_t TraceNow()
+{
+	return (int64_t)clock_now_ns();
+}
+
+static TraceThreadBuffer* GetThreadBuffer()
+{
+	if (threadBuffer == nullptr)
+	{
+		threadBuffer = new TraceThreadBuffer();
+
+		std::lock_guard<std::mutex> lock(bufferMutex);
+		threadBuffer->threadId = (int)buffers.size() + 1;
+		buffers.push_back(threadBuffer);
+	}
+	return threadBuffer;
+}
+
+void trace_begin(const char* name, const char* category)
+{
+	TraceThreadBuffer* buffer = GetThreadBuffer();
+
+	// Too deep - the matching trace_end still has to pop, so just count it
+	if (buffer->depth < TRACE_MAX_DEPTH)
+	{
+		TraceOpenZone& zone = buffer->open[buffer->depth];
+		zone.name = name;
+		zone.category = category;
+		zone.startNs = TraceNow();
+	}
+	buffer->depth++;
+}
+
+void trace_end()
+{
+	TraceThreadBuffer* buffer = GetThreadBuffer();
+	if (buffer->depth == 0)
+		return;
+
+	buffer->depth--;
+	if (buffer->depth >= TRACE_MAX_DEPTH)
+		return;
+
+	const TraceOpenZone& zone = buffer->open[buffer->depth];
+	uint64_t index = buffer->written.load(std::memory_order_relaxed);
+
+	int64_t endNs = TraceNow();
+
+	// Keeps the slot writes below after the store that published 'written' == index,
+	// so a dump that sees any of them also sees that index has been reached
+	std::atomic_thread_fence(std::memory_order_release);
+
+	TraceSlot& slot = buffer->events[index % TRACE_BUFFER_EVENTS];
+	slot.name.store(zone.name, std::memory_order_relaxed);
+	slot.category.store(zone.category, std::memory_order_relaxed);
+	slot.startNs.store(zone.startNs, std::memory_order_relaxed);
+	slot.durationNs.store(endNs - zone.startNs, std::memory_order_relaxed);
+
+	buffer->written.store(index + 1, std::memory_order_release);
+}
+
+void trace_set_thread_name(const char* name)
+{
+	TraceThreadBuffer* buffer = GetThreadBuffer();
+
+	std::lock_guard<std::mutex> lock(bufferMutex);
+	buffer->threadName = name;
+}
+
+// Zone names are our own literals, but keep the JSON valid whatever they contain
+static void WriteJsonString(FILE* file, const char* text)
+{
+	fputc('"', file);
+	for (const char* c = text ? text : ""; *c; ++c)
+	{
+		if (*c == '"' || *c == '\\') fputc('\\', file);
+		if ((unsigned char)*c >= 0x20) fputc(*c, file);
+	}
+	fputc('"', file);
+}
+
+bool trace_dump(const char* path, double seconds)
+{
+	FILE* file = fopen(path, "w");
+	if (file == nullptr)
+	{
+		LOG_ERR("Could not open trace file '%s'", path);
+		return false;
+	}
+
+	int64_t cutoffNs = TraceNow() - (int64_t)(seconds * 1e9);
+	int eventCount = 0;
+	bool first = true;
+
+	fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+	std::lock_guard<std::mutex> lock(bufferMutex);
+	for (TraceThreadBuffer* buffer : buffers)
+	{
+		// Thread name metadata
+		fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", first ? "" : ",\n", buffer->threadId);
+		WriteJsonString(file, buffer->threadName ? buffer->threadName : "Worker");
+		fprintf(file, "}}");
+		first = false;
+
+		uint64_t written = buffer->written.load(std::memory_order_acquire);
+		uint64_t oldest = (written > TRACE_BUFFER_EVENTS) ? written - TRACE_BUFFER_EVENTS : 0;
+
+		for (uint64_t i = oldest; i < written; ++i)
+		{
+			const TraceSlot& slot = buffer->events[i % TRACE_BUFFER_EVENTS];
+			TraceEvent event;
+			event.name = slot.name.load(std::memory_order_relaxed);
+			event.category = slot.category.load(std::memory_order_relaxed);
+			event.startNs = slot.startNs.load(std::memory_order_relaxed);
+			event.durationNs = slot.durationNs.load(std::memory_order_relaxed);
+
+			// The owner reaching event i + TRACE_BUFFER_EVENTS means it may have been
+			// rewriting this slot while we copied it - drop it, older slots go first
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (buffer->written.load(std::memory_order_relaxed) >= i + TRACE_BUFFER_EVENTS) continue;
+
+			if (event.startNs + event.durationNs < cutoffNs) continue;
+
+			fprintf(file, ",\n{\"name\":");
+			WriteJsonString(file, event.name);
+			fprintf(file, ",\"cat\":");
+			WriteJsonString(file, event.category);
+			fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+				buffer->threadId, event.startNs / 1000.0, event.durationNs / 1000.0);
+			eventCount++;
+		}
+	}
+
+	fprintf(file, "\n]}\n");
+	fclose(file);
+
+	LOG("Trace written to '%s' (%d events, last %.1fs)", path, eventCount, seconds);
+	return true;
+}
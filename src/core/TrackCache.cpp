@@ -0,0 +1,117 @@
+#include "core/TrackCache.h"
+#include "modules/ModuleResources.h"
+
+TrackCache::~TrackCache()
+{
+	// Whatever is left goes without its textures - the resource manager unloaded them all
+	for (CachedTrack* track : tracks)
+	{
+		FreeMapData(track->data, nullptr);
+		delete track;
+	}
+	tracks.clear();
+}
+
+CachedTrack* TrackCache::Find(const std::string& path, const std::string& fileName)
+{
+	for (CachedTrack* track : tracks)
+	{
+		if (track->path == path && track->fileName == fileName)
+			return track;
+	}
+	return nullptr;
+}
+
+CachedTrack* TrackCache::Insert(CachedTrack* track)
+{
+	tracks.push_back(track);
+	LOG("Track cache: added %s%s (%d colliders, %d tracks cached)", track->path.c_str(), track->fileName.c_str(),
+		(int)track->colliders.size(), (int)tracks.size());
+	return track;
+}
+
+void TrackCache::Acquire(CachedTrack* track)
+{
+	if (track) track->users++;
+}
+
+void TrackCache::Release(CachedTrack* track)
+{
+	if (track && track->users > 0) track->users--;
+}
+
+bool TrackCache::Evict(const std::string& path, const std::string& fileName, ModuleResources* resources)
+{
+	for (auto it = tracks.begin(); it != tracks.end(); ++it)
+	{
+		CachedTrack* track = *it;
+		if (track->path != path || track->fileName != fileName)
+			continue;
+
+		if (track->users > 0)
+		{
+			LOG_WARN("Track cache: %s%s is in use - not evicted", path.c_str(), fileName.c_str());
+			return false;
+		}
+
+		FreeMapData(track->data, resources);
+		delete track;
+		tracks.erase(it);
+		LOG("Track cache: evicted %s%s", path.c_str(), fileName.c_str());
+		return true;
+	}
+	return false;
+}
+
+void TrackCache::EvictAll(ModuleResources* resources)
+{
+	for (auto it = tracks.begin(); it != tracks.end();)
+	{
+		CachedTrack* track = *it;
+		if (track->users > 0)
+		{
+			LOG_WARN("Track cache: %s%s is in use - not evicted", track->path.c_str(), track->fileName.c_str());
+			++it;
+			continue;
+		}
+
+		FreeMapData(track->data, resources);
+		delete track;
+		it = tracks.erase(it);
+	}
+}
+
+void TrackCache::FreeMapData(MapData& data, ModuleResources* resources)
+{
+	for (const auto& tileset : data.tilesets)
+	{
+		if (resources && !tileset->imagePath.empty())
+		{
+			resources->UnloadTexture(tileset->imagePath.c_str());
+		}
+		delete tileset;
+	}
+	data.tilesets.clear();
+
+	for (const auto& layer : data.layers)
+	{
+		delete layer;
+	}
+	data.layers.clear();
+
+	for (const auto& imageLayer : data.imageLayers)
+	{
+		if (resources && !imageLayer->imagePath.empty())
+		{
+			resources->UnloadTexture(imageLayer->imagePath.c_str());
+		}
+		delete imageLayer;
+	}
+	data.imageLayers.clear();
+
+	for (const auto& object : data.objects)
+	{
+		delete object;
+	}
+	data.objects.clear();
+}
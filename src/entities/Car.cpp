@@ -2,9 +2,10 @@
 #include "core/Application.h"
 #include "core/Map.h"
 #include "modules/ModulePhysics.h"
-#include "modules/ModuleRender.h"
 #include "modules/ModuleResources.h"
 #include "entities/PhysBody.h"
+#include "core/StateStream.h"
+#include "core/EventBus.h"
 #include <math.h>
 
 // Default car physics values (tunable)
@@ -21,23 +22,22 @@
 
 Car::Car(Application* app)
 	: Entity(app)
-	, accelerationForce(DEFAULT_ACCELERATION)
-	, reverseForce(DEFAULT_REVERSE_FORCE)
-	, brakeForce(DEFAULT_BRAKE_FORCE)
-	, maxSpeed(DEFAULT_MAX_SPEED)
-	, reverseMaxSpeed(DEFAULT_REVERSE_MAX_SPEED)
-	, steeringSensitivity(DEFAULT_STEERING_SENSITIVITY)
-	, driftImpulse(DEFAULT_DRIFT_IMPULSE)
+	, store(*app->cars)
+	, carId(app->cars->Create(this))
 	, texture({ 0 })
 	, tint(WHITE)
 	, renderScale(0.075f)
-	, currentTerrain(NORMAL)
-	, terrainFrictionModifier(1.0f)
-	, terrainAccelerationModifier(1.0f)
-	, terrainSpeedModifier(1.0f)
+	, effectsRandom(app->GetRandomSeed(), RandomStreamId(RANDOM_STREAM_EFFECTS, (uint32_t)carId))
 	, motorSound({ 0 })
 	, isMotorPlaying(false)
 {
+	store.accelerationForce[carId] = DEFAULT_ACCELERATION;
+	store.reverseForce[carId] = DEFAULT_REVERSE_FORCE;
+	store.brakeForce[carId] = DEFAULT_BRAKE_FORCE;
+	store.maxSpeed[carId] = DEFAULT_MAX_SPEED;
+	store.reverseMaxSpeed[carId] = DEFAULT_REVERSE_MAX_SPEED;
+	store.steeringSensitivity[carId] = DEFAULT_STEERING_SENSITIVITY;
+	store.driftImpulse[carId] = DEFAULT_DRIFT_IMPULSE;
 }
 
 Car::~Car()
@@ -55,6 +55,8 @@ Car::~Car()
 		app->physics->DestroyBody(physBody);
 		physBody = nullptr;
 	}
+
+	store.Destroy(carId);
 }
 
 bool Car::Start()
@@ -70,7 +72,7 @@ bool Car::Start()
 
 	if (!physBody)
 	{
-		LOG("ERROR: Failed to create Car physics body");
+		LOG_ERR("Failed to create Car physics body");
 		return false;
 	}
 
@@ -90,6 +92,10 @@ bool Car::Start()
 	// Set user data to reference this car
 	physBody->SetUserData(this);
 
+	// The store mirrors the body from now on
+	store.body[carId] = physBody;
+	store.SyncFromBody(carId);
+
 	// Load car texture
 	texture = app->resources->LoadTexture("assets/sprites/car_player.png");
 	if (texture.id != 0)
@@ -98,7 +104,7 @@ bool Car::Start()
 	}
 	else
 	{
-		LOG("WARNING: Failed to load car texture, using fallback rectangle");
+		LOG_WARN("Failed to load car texture, using fallback rectangle");
 	}
 
 	// Load motor sound
@@ -113,7 +119,7 @@ bool Car::Start()
 		}
 		else
 		{
-			LOG("WARNING: Failed to load car motor sound");
+			LOG_WARN("Failed to load car motor sound");
 		}
 	}
 
@@ -138,9 +144,6 @@ update_status Car::Update()
 	// Clamp speed to max speed
 	ClampSpeed();
 
-	// Update motor sound based on movement
-	UpdateMotorSound();
-
 	return UPDATE_CONTINUE;
 }
 
@@ -171,7 +174,7 @@ void Car::UpdateMotorSound()
 		}
 
 		// Adjust pitch based on speed (makes motor sound more realistic)
-		float speedRatio = currentSpeed / maxSpeed;  // 0.0 to 1.0
+		float speedRatio = currentSpeed / store.maxSpeed[carId];  // 0.0 to 1.0
 		float pitch = 0.8f + (speedRatio * 0.4f);     // Pitch from 0.8 to 1.2
 		SetMusicPitch(motorSound, pitch);
 	}
@@ -192,27 +195,28 @@ void Car::Draw() const
 		return;
 
 	float x, y;
-	GetPosition(x, y);
-	float rotation = GetRotation();
+	GetRenderPosition(x, y);
+	float rotation = GetRenderRotation();
 
 	// Draw particles for terrain effects
+	TerrainType currentTerrain = (TerrainType)store.terrain[carId];
 	if (currentTerrain == MUD && GetCurrentSpeed() > 10.0f)
 	{
 		// Draw mud particles behind the car
-		for (int i = 0; i < 3; i++)
+		for (int i = 0; i < app->GetQuality().mudParticles; i++)
 		{
-			float offsetX = x - 10.0f + GetRandomValue(-20, 20);
-			float offsetY = y + 20.0f + GetRandomValue(-10, 10);
+			float offsetX = x - 10.0f + effectsRandom.Range(-20, 20);
+			float offsetY = y + 20.0f + effectsRandom.Range(-10, 10);
 			DrawRectangle(offsetX, offsetY, 4, 4, BROWN);
 		}
 	}
 	else if (currentTerrain == WATER && GetCurrentSpeed() > 5.0f)
 	{
 		// Draw water splash particles
-		for (int i = 0; i < 2; i++)
+		for (int i = 0; i < app->GetQuality().waterParticles; i++)
 		{
-			float offsetX = x + GetRandomValue(-15, 15);
-			float offsetY = y + GetRandomValue(-15, 15);
+			float offsetX = x + effectsRandom.Range(-15, 15);
+			float offsetY = y + effectsRandom.Range(-15, 15);
 			DrawCircle(offsetX, offsetY, 3, BLUE);
 		}
 	}
@@ -252,7 +256,7 @@ void Car::Accelerate(float amount)
 	vec2f forward = GetForwardVector();
 
 	// Apply force in forward direction with terrain modifier
-	float effectiveAcceleration = accelerationForce * terrainAccelerationModifier;
+	float effectiveAcceleration = store.accelerationForce[carId] * store.accelerationModifier[carId];
 	float forceX = forward.x * effectiveAcceleration * amount;
 	float forceY = forward.y * effectiveAcceleration * amount;
 
@@ -271,7 +275,7 @@ void Car::Reverse(float amount)
 	vec2f forward = GetForwardVector();
 
 	// Apply force in backward direction (negative forward) with terrain modifier
-	float effectiveReverse = reverseForce * terrainAccelerationModifier;
+	float effectiveReverse = store.reverseForce[carId] * store.accelerationModifier[carId];
 	float forceX = -forward.x * effectiveReverse * amount;
 	float forceY = -forward.y * effectiveReverse * amount;
 
@@ -287,8 +291,8 @@ void Car::Brake(float amount)
 	amount = (amount > 1.0f) ? 1.0f : amount;
 
 	// Get current velocity
-	float vx, vy;
-	physBody->GetLinearVelocity(vx, vy);
+	float vx = store.velX[carId];
+	float vy = store.velY[carId];
 
 	// Apply force opposite to velocity direction
 	float speed = sqrtf(vx * vx + vy * vy);
@@ -297,8 +301,8 @@ void Car::Brake(float amount)
 		float normalizedVx = vx / speed;
 		float normalizedVy = vy / speed;
 
-		float brakeX = -normalizedVx * brakeForce * amount;
-		float brakeY = -normalizedVy * brakeForce * amount;
+		float brakeX = -normalizedVx * store.brakeForce[carId] * amount;
+		float brakeY = -normalizedVy * store.brakeForce[carId] * amount;
 
 		physBody->ApplyForce(brakeX, brakeY);
 	}
@@ -313,7 +317,7 @@ void Car::Steer(float direction)
 	direction = (direction < -1.0f) ? -1.0f : (direction > 1.0f) ? 1.0f : direction;
 
 	// Apply angular velocity for steering
-	float angularVelocity = direction * steeringSensitivity;
+	float angularVelocity = direction * store.steeringSensitivity[carId];
 	physBody->SetAngularVelocity(angularVelocity);
 }
 
@@ -326,47 +330,90 @@ void Car::Drift()
 	vec2f right = GetRightVector();
 
 	// Get current velocity
-	float vx, vy;
-	physBody->GetLinearVelocity(vx, vy);
+	float vx = store.velX[carId];
+	float vy = store.velY[carId];
 
 	// Calculate lateral velocity (velocity along right vector)
 	float lateralVelocity = vx * right.x + vy * right.y;
 
 	// Apply impulse opposite to lateral velocity to simulate drift
+	float driftImpulse = store.driftImpulse[carId];
 	float impulseX = -lateralVelocity * right.x * driftImpulse * 0.01f;
 	float impulseY = -lateralVelocity * right.y * driftImpulse * 0.01f;
 
+	// Impulses change the velocity right away
 	physBody->ApplyLinearImpulse(impulseX, impulseY);
+	store.SyncFromBody(carId);
+}
+
+void Car::GetPosition(float& x, float& y) const
+{
+	x = store.posX[carId];
+	y = store.posY[carId];
+}
+
+void Car::SetPosition(float x, float y)
+{
+	Entity::SetPosition(x, y);
+	store.SyncFromBody(carId);
+}
+
+float Car::GetRotation() const
+{
+	return store.rotation[carId];
+}
+
+void Car::SetRotation(float degrees)
+{
+	Entity::SetRotation(degrees);
+	store.SyncFromBody(carId);
 }
 
 void Car::SetMaxSpeed(float speed)
 {
-	maxSpeed = speed;
+	store.maxSpeed[carId] = speed;
+}
+
+float Car::GetMaxSpeed() const
+{
+	return store.maxSpeed[carId];
 }
 
 void Car::SetReverseSpeed(float speed)
 {
-	reverseMaxSpeed = speed;
+	store.reverseMaxSpeed[carId] = speed;
 }
 
-float Car::GetCurrentSpeed() const
+float Car::GetReverseSpeed() const
 {
-	if (!physBody)
-		return 0.0f;
+	return store.reverseMaxSpeed[carId];
+}
 
-	float vx, vy;
-	physBody->GetLinearVelocity(vx, vy);
+float Car::GetCurrentSpeed() const
+{
+	float vx = store.velX[carId];
+	float vy = store.velY[carId];
 	return sqrtf(vx * vx + vy * vy);
 }
 
 void Car::SetAcceleration(float accel)
 {
-	accelerationForce = accel;
+	store.accelerationForce[carId] = accel;
+}
+
+float Car::GetAcceleration() const
+{
+	return store.accelerationForce[carId];
 }
 
 void Car::SetSteeringSensitivity(float sensitivity)
 {
-	steeringSensitivity = sensitivity;
+	store.steeringSensitivity[carId] = sensitivity;
+}
+
+float Car::GetSteeringSensitivity() const
+{
+	return store.steeringSensitivity[carId];
 }
 
 void Car::SetTexture(Texture2D tex)
@@ -385,12 +432,12 @@ void Car::ApplyFriction()
 		return;
 
 	// Get current velocity
-	float vx, vy;
-	physBody->GetLinearVelocity(vx, vy);
+	float vx = store.velX[carId];
+	float vy = store.velY[carId];
 
 	// Apply friction coefficient with terrain modifier
-	float effectiveFriction = FRICTION_COEFFICIENT * terrainFrictionModifier;
-	physBody->SetLinearVelocity(vx * effectiveFriction, vy * effectiveFriction);
+	float effectiveFriction = FRICTION_COEFFICIENT * store.frictionModifier[carId];
+	SetVelocity(vx * effectiveFriction, vy * effectiveFriction);
 }
 
 void Car::ClampSpeed()
@@ -398,8 +445,8 @@ void Car::ClampSpeed()
 	if (!physBody)
 		return;
 
-	float vx, vy;
-	physBody->GetLinearVelocity(vx, vy);
+	float vx = store.velX[carId];
+	float vy = store.velY[carId];
 
 	float speed = sqrtf(vx * vx + vy * vy);
 
@@ -408,16 +455,24 @@ void Car::ClampSpeed()
 	float forwardDot = vx * forward.x + vy * forward.y;
 
 	// Clamp based on direction with terrain speed modifier applied
-	float baseSpeedLimit = (forwardDot >= 0.0f) ? maxSpeed : reverseMaxSpeed;
-	float speedLimit = baseSpeedLimit * terrainSpeedModifier;  // Use speed modifier instead of acceleration modifier
+	float baseSpeedLimit = (forwardDot >= 0.0f) ? store.maxSpeed[carId] : store.reverseMaxSpeed[carId];
+	float speedLimit = baseSpeedLimit * store.speedModifier[carId];  // Use speed modifier instead of acceleration modifier
 
 	if (speed > speedLimit)
 	{
 		float scale = speedLimit / speed;
-		physBody->SetLinearVelocity(vx * scale, vy * scale);
+		SetVelocity(vx * scale, vy * scale);
 	}
 }
 
+// Sets the body's velocity and mirrors it back as Box2D stores it (meters), so the
+// store always holds exactly what the body reports
+void Car::SetVelocity(float vx, float vy)
+{
+	physBody->SetLinearVelocity(vx, vy);
+	physBody->GetLinearVelocity(store.velX[carId], store.velY[carId]);
+}
+
 vec2f Car::GetForwardVector() const
 {
 	if (!physBody)
@@ -479,7 +534,7 @@ Car::TerrainType Car::GetCurrentTerrain() const
 	GetPosition(carX, carY);
 
 	// Check collision with terrain objects
-	for (const auto& object : app->map->mapData.objects)
+	for (const auto& object : app->map->GetMapData().objects)
 	{
 		// Only check terrain collision objects
 		if (object->type != "Mud" && object->type != "Water")
@@ -517,13 +572,62 @@ Car::TerrainType Car::GetCurrentTerrain() const
 	return NORMAL;
 }
 
+void Car::SampleTerrain()
+{
+	store.sampledTerrain[carId] = (uint8_t)GetCurrentTerrain();
+	store.terrainSampled[carId] = 1;
+}
+
+void Car::SaveState(StateWriter& writer) const
+{
+	if (physBody) physBody->SaveState(writer);
+
+	writer.Write((TerrainType)store.terrain[carId]);
+	writer.Write((TerrainType)store.sampledTerrain[carId]);
+	writer.Write(store.terrainSampled[carId] != 0);
+	writer.Write(store.frictionModifier[carId]);
+	writer.Write(store.accelerationModifier[carId]);
+	writer.Write(store.speedModifier[carId]);
+}
+
+bool Car::LoadState(StateReader& reader)
+{
+	if (physBody && !physBody->LoadState(reader))
+		return false;
+
+	TerrainType currentTerrain = NORMAL, sampledTerrain = NORMAL;
+	bool terrainSampled = false;
+	reader.Read(currentTerrain);
+	reader.Read(sampledTerrain);
+	reader.Read(terrainSampled);
+	reader.Read(store.frictionModifier[carId]);
+	reader.Read(store.accelerationModifier[carId]);
+	reader.Read(store.speedModifier[carId]);
+	if (!reader.IsValid())
+		return false;
+
+	store.terrain[carId] = (uint8_t)currentTerrain;
+	store.sampledTerrain[carId] = (uint8_t)sampledTerrain;
+	store.terrainSampled[carId] = terrainSampled ? 1 : 0;
+	store.SyncFromBody(carId);
+	return true;
+}
+
 void Car::UpdateTerrainEffects()
 {
-	TerrainType newTerrain = GetCurrentTerrain();
+	// Use the terrain sampled this step if there is one, otherwise look it up now
+	TerrainType newTerrain = store.terrainSampled[carId] ? (TerrainType)store.sampledTerrain[carId] : GetCurrentTerrain();
+	store.terrainSampled[carId] = 0;
+
+	float& terrainFrictionModifier = store.frictionModifier[carId];
+	float& terrainAccelerationModifier = store.accelerationModifier[carId];
+	float& terrainSpeedModifier = store.speedModifier[carId];
 
+	TerrainType currentTerrain = (TerrainType)store.terrain[carId];
 	if (newTerrain != currentTerrain)
 	{
 		currentTerrain = newTerrain;
+		store.terrain[carId] = (uint8_t)currentTerrain;
 
 		// Set terrain modifiers based on terrain type
 		switch (currentTerrain)
@@ -538,14 +642,14 @@ void Car::UpdateTerrainEffects()
 			terrainAccelerationModifier = 0.85f;  // Aceleraci�n al 85% (mejor que antes)
 			terrainSpeedModifier = 0.9f;  // Velocidad al 85% = 59.5 px/s (m�s r�pido)
 			// Add screen shake for rough terrain
-			if (app && app->renderer) app->renderer->AddScreenShake(3.0f);
+			if (app) app->events->PostScreenShake(3.0f);
 			break;
 		case WATER:
 			terrainFrictionModifier = 0.995f;  // CASI NULA fricci�n = m�ximo derrape
 			terrainAccelerationModifier = 1.8f;  // Aceleraci�n MUCHO m�s r�pida (180%)
 			terrainSpeedModifier = 2.5f;  // Velocidad al 250% = 175 px/s (MUY R�PIDO)
 			// Add screen shake for splash
-			if (app && app->renderer) app->renderer->AddScreenShake(3.0f);
+			if (app) app->events->PostScreenShake(3.0f);
 			break;
 		}
 
@@ -0,0 +1,119 @@
+#include "entities/CarStore.h"
+#include "entities/PhysBody.h"
+#include "core/Timer.h"
+
+// Slots reserved up front - a race has the player and three NPCs
+#define CAR_STORE_INITIAL_CAPACITY 8
+
+CarStore::CarStore()
+{
+	owner.reserve(CAR_STORE_INITIAL_CAPACITY);
+	body.reserve(CAR_STORE_INITIAL_CAPACITY);
+	posX.reserve(CAR_STORE_INITIAL_CAPACITY);
+	posY.reserve(CAR_STORE_INITIAL_CAPACITY);
+	rotation.reserve(CAR_STORE_INITIAL_CAPACITY);
+	velX.reserve(CAR_STORE_INITIAL_CAPACITY);
+	velY.reserve(CAR_STORE_INITIAL_CAPACITY);
+	terrain.reserve(CAR_STORE_INITIAL_CAPACITY);
+	sampledTerrain.reserve(CAR_STORE_INITIAL_CAPACITY);
+	terrainSampled.reserve(CAR_STORE_INITIAL_CAPACITY);
+	frictionModifier.reserve(CAR_STORE_INITIAL_CAPACITY);
+	accelerationModifier.reserve(CAR_STORE_INITIAL_CAPACITY);
+	speedModifier.reserve(CAR_STORE_INITIAL_CAPACITY);
+	accelerationForce.reserve(CAR_STORE_INITIAL_CAPACITY);
+	reverseForce.reserve(CAR_STORE_INITIAL_CAPACITY);
+	brakeForce.reserve(CAR_STORE_INITIAL_CAPACITY);
+	maxSpeed.reserve(CAR_STORE_INITIAL_CAPACITY);
+	reverseMaxSpeed.reserve(CAR_STORE_INITIAL_CAPACITY);
+	steeringSensitivity.reserve(CAR_STORE_INITIAL_CAPACITY);
+	driftImpulse.reserve(CAR_STORE_INITIAL_CAPACITY);
+	ai.reserve(CAR_STORE_INITIAL_CAPACITY);
+	hasAI.reserve(CAR_STORE_INITIAL_CAPACITY);
+	freeSlots.reserve(CAR_STORE_INITIAL_CAPACITY);
+}
+
+CarStore::~CarStore()
+{
+}
+
+CarId CarStore::Create(Car* car)
+{
+	CarId id;
+	if (!freeSlots.empty())
+	{
+		id = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else
+	{
+		id = (CarId)owner.size();
+		owner.push_back(nullptr);
+		body.push_back(nullptr);
+		posX.push_back(0.0f);
+		posY.push_back(0.0f);
+		rotation.push_back(0.0f);
+		velX.push_back(0.0f);
+		velY.push_back(0.0f);
+		terrain.push_back(0);
+		sampledTerrain.push_back(0);
+		terrainSampled.push_back(0);
+		frictionModifier.push_back(1.0f);
+		accelerationModifier.push_back(1.0f);
+		speedModifier.push_back(1.0f);
+		accelerationForce.push_back(0.0f);
+		reverseForce.push_back(0.0f);
+		brakeForce.push_back(0.0f);
+		maxSpeed.push_back(0.0f);
+		reverseMaxSpeed.push_back(0.0f);
+		steeringSensitivity.push_back(0.0f);
+		driftImpulse.push_back(0.0f);
+		ai.push_back(NPCState());
+		hasAI.push_back(0);
+	}
+
+	// A reused slot starts like a new one - the owner sets its tuning
+	owner[id] = car;
+	body[id] = nullptr;
+	posX[id] = posY[id] = rotation[id] = 0.0f;
+	velX[id] = velY[id] = 0.0f;
+	terrain[id] = sampledTerrain[id] = terrainSampled[id] = 0;
+	frictionModifier[id] = accelerationModifier[id] = speedModifier[id] = 1.0f;
+	accelerationForce[id] = reverseForce[id] = brakeForce[id] = 0.0f;
+	maxSpeed[id] = reverseMaxSpeed[id] = 0.0f;
+	steeringSensitivity[id] = driftImpulse[id] = 0.0f;
+	ai[id] = NPCState();
+	hasAI[id] = 0;
+	return id;
+}
+
+void CarStore::Destroy(CarId id)
+{
+	if (!IsAlive(id))
+		return;
+
+	owner[id] = nullptr;
+	body[id] = nullptr;
+	hasAI[id] = 0;
+	freeSlots.push_back(id);
+}
+
+void CarStore::SyncFromBodies()
+{
+	SCOPED_TIMER("CarStore::SyncFromBodies");
+
+	for (CarId id = 0; id < (CarId)body.size(); ++id)
+	{
+		if (body[id]) SyncFromBody(id);
+	}
+}
+
+void CarStore::SyncFromBody(CarId id)
+{
+	PhysBody* physBody = body[id];
+	if (!physBody)
+		return;
+
+	physBody->GetPositionF(posX[id], posY[id]);
+	rotation[id] = physBody->GetRotation();
+	physBody->GetLinearVelocity(velX[id], velY[id]);
+}
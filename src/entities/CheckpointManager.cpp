@@ -8,6 +8,8 @@
 #include "entities/Player.h"
 #include "entities/NPCManager.h"
 #include "entities/Car.h"
+#include "core/StateStream.h"
+#include "core/EventBus.h"
 #include "raylib.h"
 #include <algorithm>
 
@@ -20,6 +22,7 @@ CheckpointManager::CheckpointManager(Application* app, bool start_enabled)
 	, totalLaps(5)
 	, raceFinished(false)
 	, playerBody(nullptr)
+	, finishedCars(0)
 	, lapCompleteSfxId(0)
 	, countdownBeepSfxId(0)
 	, countdownGoSfxId(0)
@@ -41,6 +44,13 @@ CheckpointManager::~CheckpointManager()
 {
 }
 
+// The race intro moves the camera towards the player's car
+void CheckpointManager::DeclareAccess()
+{
+	Reads({ App->player });
+	Writes({ App->renderer });
+}
+
 bool CheckpointManager::Start()
 {
 	LOG("Initializing Checkpoint Manager");
@@ -60,7 +70,8 @@ bool CheckpointManager::Start()
 	raceFinished = false;
 	
 	// Initialize get ready, intro and countdown
-	raceState = RACE_GET_READY;
+	// Headless runs have nobody watching - start racing straight away
+	raceState = App->IsHeadless() ? RACE_RUNNING : RACE_GET_READY;
 	getReadyTimer = 0.0f;
 	getReadyDuration = 3.0f;  // 3 second pause showing "GET READY!"
 	introTimer = 0.0f;
@@ -75,11 +86,13 @@ bool CheckpointManager::Start()
 
 	if (!playerBody)
 	{
-		LOG("ERROR: CheckpointManager - Player body not found!");
+		LOG_ERR("CheckpointManager - Player body not found!");
 		return false;
 	}
 
 	LoadCheckpointsFromMap();
+	RegisterCars();
+	if (raceState == RACE_RUNNING) StartRaceClock();
 
 	// Load sound effects
 	if (App->audio)
@@ -92,8 +105,8 @@ bool CheckpointManager::Start()
 	// Start at map center (overview) - convert tile coordinates to pixel coordinates
 	if (App->map)
 	{
-		introStartX = (float)(App->map->mapData.width * App->map->mapData.tileWidth) * 0.5f;
-		introStartY = (float)(App->map->mapData.height * App->map->mapData.tileHeight) * 0.5f;
+		introStartX = (float)(App->map->GetMapData().width * App->map->GetMapData().tileWidth) * 0.5f;
+		introStartY = (float)(App->map->GetMapData().height * App->map->GetMapData().tileHeight) * 0.5f;
 	}
 	else
 	{
@@ -123,18 +136,20 @@ bool CheckpointManager::Start()
 	return true;
 }
 
-update_status CheckpointManager::Update()
+// Get ready, intro and countdown run on the simulation clock - they decide the step
+// the race starts on, so it must not depend on frame times (or the time scale)
+update_status CheckpointManager::FixedUpdate(float dt)
 {
 	switch (raceState)
 	{
 	case RACE_GET_READY:
-		UpdateGetReady();
+		UpdateGetReady(dt);
 		break;
 	case RACE_INTRO:
-		UpdateIntro();
+		UpdateIntro(dt);
 		break;
 	case RACE_COUNTDOWN:
-		UpdateCountdown();
+		UpdateCountdown(dt);
 		break;
 	case RACE_RUNNING:
 		// Normal race logic handled elsewhere
@@ -143,26 +158,19 @@ update_status CheckpointManager::Update()
 		// Win state - nothing to update
 		break;
 	}
-	
+
 	return UPDATE_CONTINUE;
 }
 
-void CheckpointManager::UpdateGetReady()
+update_status CheckpointManager::Update()
 {
-	// Clamp delta time to prevent skipping due to long loading frame
-	float deltaTime = GetFrameTime();
-	if (deltaTime > 0.1f) deltaTime = 0.1f; // Cap at 100ms per frame
-	
-	getReadyTimer += deltaTime;
-	
-	// Set camera to overview position (zoomed out, no rotation)
-	if (App->renderer)
-	{
-		App->renderer->camera.target.x = introStartX;
-		App->renderer->camera.target.y = introStartY;
-		App->renderer->camera.rotation = 0.0f;
-		App->renderer->camera.zoom = 0.15f;  // Zoomed out overview
-	}
+	UpdatePreRaceCamera();
+	return UPDATE_CONTINUE;
+}
+
+void CheckpointManager::UpdateGetReady(float dt)
+{
+	getReadyTimer += dt;
 	
 	// Transition to intro (camera pan) when GET READY pause is done
 	if (getReadyTimer >= getReadyDuration)
@@ -173,30 +181,46 @@ void CheckpointManager::UpdateGetReady()
 	}
 }
 
-void CheckpointManager::UpdateIntro()
+void CheckpointManager::UpdateIntro(float dt)
 {
-	// Clamp delta time to prevent skipping intro due to long loading frame
-	float deltaTime = GetFrameTime();
-	if (deltaTime > 0.1f) deltaTime = 0.1f; // Cap at 100ms per frame
-	
-	introTimer += deltaTime;
-	
-	// Calculate interpolation factor (0 to 1)
-	float t = introTimer / introDuration;
-	if (t > 1.0f) t = 1.0f;
+	introTimer += dt;
 	
-	// Smooth easing (ease-in-out)
-	float smoothT = t * t * (3.0f - 2.0f * t);
-	
-	// Interpolate camera position
-	float camX = introStartX + (introEndX - introStartX) * smoothT;
-	float camY = introStartY + (introEndY - introStartY) * smoothT;
-	
-	// Update camera target directly
-	if (App->renderer)
+	// Transition to countdown when intro is done
+	if (introTimer >= introDuration)
+	{
+		raceState = RACE_COUNTDOWN;
+		countdownTimer = 4.0f;
+		lastCountdownNumber = 4;
+		LOG("Intro complete - starting countdown");
+	}
+}
+
+// Camera for the GET READY overview and the intro pan, placed every frame from the timers
+void CheckpointManager::UpdatePreRaceCamera()
+{
+	if (!App->renderer)
+		return;
+
+	if (raceState == RACE_GET_READY)
+	{
+		// Overview position (zoomed out, no rotation)
+		App->renderer->camera.target.x = introStartX;
+		App->renderer->camera.target.y = introStartY;
+		App->renderer->camera.rotation = 0.0f;
+		App->renderer->camera.zoom = 0.15f;  // Zoomed out overview
+	}
+	else if (raceState == RACE_INTRO)
 	{
-		App->renderer->camera.target.x = camX;
-		App->renderer->camera.target.y = camY;
+		// Calculate interpolation factor (0 to 1)
+		float t = introTimer / introDuration;
+		if (t > 1.0f) t = 1.0f;
+		
+		// Smooth easing (ease-in-out)
+		float smoothT = t * t * (3.0f - 2.0f * t);
+		
+		// Interpolate camera position
+		App->renderer->camera.target.x = introStartX + (introEndX - introStartX) * smoothT;
+		App->renderer->camera.target.y = introStartY + (introEndY - introStartY) * smoothT;
 		
 		// Smooth rotation from 0 to player's starting rotation
 		App->renderer->camera.rotation = introEndRotation * smoothT;
@@ -206,20 +230,11 @@ void CheckpointManager::UpdateIntro()
 		float endZoom = 1.0f;
 		App->renderer->camera.zoom = startZoom + (endZoom - startZoom) * smoothT;
 	}
-	
-	// Transition to countdown when intro is done
-	if (introTimer >= introDuration)
-	{
-		raceState = RACE_COUNTDOWN;
-		countdownTimer = 4.0f;
-		lastCountdownNumber = 4;
-		LOG("Intro complete - starting countdown");
-	}
 }
 
-void CheckpointManager::UpdateCountdown()
+void CheckpointManager::UpdateCountdown(float dt)
 {
-	countdownTimer -= GetFrameTime();
+	countdownTimer -= dt;
 	
 	// Get current countdown number
 	int currentNumber = (int)countdownTimer;
@@ -230,7 +245,7 @@ void CheckpointManager::UpdateCountdown()
 		lastCountdownNumber = currentNumber;
 		if (App->audio && countdownBeepSfxId > 0 && currentNumber > 0)
 		{
-			App->audio->PlayFx(countdownBeepSfxId);
+			App->events->PostSound(countdownBeepSfxId);
 		}
 	}
 	
@@ -238,12 +253,13 @@ void CheckpointManager::UpdateCountdown()
 	if (countdownTimer <= 0.0f)
 	{
 		raceState = RACE_RUNNING;
+		StartRaceClock();
 		LOG("GO! Race started!");
 		
 		// Play a "GO" sound (reuse beep for now)
 		if (App->audio && countdownBeepSfxId > 0)
 		{
-			App->audio->PlayFx(countdownBeepSfxId);
+			App->events->PostSound(countdownBeepSfxId);
 		}
 	}
 }
@@ -308,6 +324,16 @@ void CheckpointManager::DrawWinScreen()
 		lapsFontSize,
 		LIGHTGRAY);
 
+	// Restart hint (Application handles the key)
+	const char* restartText = "Press R to race again";
+	int restartFontSize = 24;
+	int restartWidth = MeasureText(restartText, restartFontSize);
+	DrawText(restartText,
+		SCREEN_WIDTH / 2 - restartWidth / 2,
+		SCREEN_HEIGHT / 2 + 110,
+		restartFontSize,
+		GRAY);
+
 }
 
 void CheckpointManager::DrawCountdown()
@@ -412,19 +438,98 @@ bool CheckpointManager::CleanUp()
 	return true;
 }
 
+// Race progress and intro/countdown timers (sensors and sounds stay as they are)
+void CheckpointManager::SaveState(StateWriter& writer) const
+{
+	writer.Write(currentLap);
+	writer.Write(nextCheckpointOrder);
+	writer.Write(raceFinished);
+	writer.Write(raceState);
+	writer.Write(getReadyTimer);
+	writer.Write(introTimer);
+	writer.Write(countdownTimer);
+	writer.Write(lastCountdownNumber);
+
+	writer.Write((uint32_t)checkpoints.size());
+	for (const Checkpoint& checkpoint : checkpoints)
+	{
+		writer.Write(checkpoint.crossed);
+	}
+
+	writer.Write(finishedCars);
+	writer.Write((uint32_t)carProgress.size());
+	for (const CarProgress& progress : carProgress)
+	{
+		writer.Write(progress.lap);
+		writer.Write(progress.nextCheckpoint);
+		writer.Write(progress.lapStartStep);
+		writer.Write(progress.place);
+		writer.Write(progress.finishStep);
+		writer.Write((uint32_t)progress.lapSteps.size());
+		for (uint64 lapStep : progress.lapSteps)
+		{
+			writer.Write(lapStep);
+		}
+	}
+}
+
+bool CheckpointManager::LoadState(StateReader& reader)
+{
+	reader.Read(currentLap);
+	reader.Read(nextCheckpointOrder);
+	reader.Read(raceFinished);
+	reader.Read(raceState);
+	reader.Read(getReadyTimer);
+	reader.Read(introTimer);
+	reader.Read(countdownTimer);
+	reader.Read(lastCountdownNumber);
+
+	uint32_t count = 0;
+	if (!reader.Read(count) || count != checkpoints.size())
+		return false;
+
+	for (Checkpoint& checkpoint : checkpoints)
+	{
+		reader.Read(checkpoint.crossed);
+	}
+
+	reader.Read(finishedCars);
+	if (!reader.Read(count) || count != carProgress.size())
+		return false;
+
+	for (CarProgress& progress : carProgress)
+	{
+		uint32_t laps = 0;
+		reader.Read(progress.lap);
+		reader.Read(progress.nextCheckpoint);
+		reader.Read(progress.lapStartStep);
+		reader.Read(progress.place);
+		reader.Read(progress.finishStep);
+		if (!reader.Read(laps) || laps > (uint32_t)totalLaps)
+			return false;
+
+		progress.lapSteps.resize(laps);
+		for (uint64& lapStep : progress.lapSteps)
+		{
+			reader.Read(lapStep);
+		}
+	}
+	return reader.IsValid();
+}
+
 void CheckpointManager::LoadCheckpointsFromMap()
 {
 	if (!App->map)
 	{
-		LOG("ERROR: CheckpointManager - Map module not available");
+		LOG_ERR("CheckpointManager - Map module not available");
 		return;
 	}
 
 	LOG("=== CHECKPOINT LOADING DEBUG ===");
-	LOG("Total map objects found: %d", (int)App->map->mapData.objects.size());
+	LOG("Total map objects found: %d", (int)App->map->GetMapData().objects.size());
 
 	int checkpointCount = 0;
-	for (const auto& object : App->map->mapData.objects)
+	for (const auto& object : App->map->GetMapData().objects)
 	{
 		LOG("Object found: name='%s', type='%s', at (%d,%d) size (%d,%d)",
 			object->name.c_str(),
@@ -472,7 +577,7 @@ void CheckpointManager::LoadCheckpointsFromMap()
 
 	if (!finishLine)
 	{
-		LOG("WARNING: No finish line (checkpoint with order=0) found!");
+		LOG_WARN("No finish line (checkpoint with order=0) found!");
 	}
 
 	LOG("=== CHECKPOINT LOADING COMPLETE ===");
@@ -507,7 +612,7 @@ void CheckpointManager::CreateCheckpointSensor(MapObject* object, int order)
 
 	if (!sensor)
 	{
-		LOG("ERROR: Failed to create checkpoint sensor for %s", object->name.c_str());
+		LOG_ERR("Failed to create checkpoint sensor for %s", object->name.c_str());
 		return;
 	}
 
@@ -544,20 +649,12 @@ Checkpoint* CheckpointManager::FindCheckpointBySensor(PhysBody* sensor)
 	return nullptr;
 }
 
-void CheckpointManager::OnCollisionEnter(PhysBody* other)
+Checkpoint* CheckpointManager::FindNearestCheckpoint(PhysBody* car)
 {
-	if (raceFinished)
-		return;
-
-	if (!other || other != playerBody)
-		return;
-
-	LOG("Player collision with checkpoint sensor detected!");
-
 	float carX, carY;
-	other->GetPositionF(carX, carY);
+	car->GetPositionF(carX, carY);
 
-	Checkpoint* hitCheckpoint = nullptr;
+	Checkpoint* nearest = nullptr;
 	float minDistance = FLT_MAX;
 
 	for (auto& checkpoint : checkpoints)
@@ -575,20 +672,118 @@ void CheckpointManager::OnCollisionEnter(PhysBody* other)
 		if (distance < minDistance)
 		{
 			minDistance = distance;
-			hitCheckpoint = &checkpoint;
+			nearest = &checkpoint;
 		}
 	}
+	return nearest;
+}
+
+void CheckpointManager::OnCollisionEnter(PhysBody* other)
+{
+	if (!other)
+		return;
+
+	CarProgress* progress = nullptr;
+	for (CarProgress& car : carProgress)
+	{
+		if (car.body == other) { progress = &car; break; }
+	}
+
+	bool isPlayer = (other == playerBody) && !raceFinished;
+	if (!progress && !isPlayer)
+		return;
+
+	if (isPlayer)
+	{
+		LOG_DBG("Player collision with checkpoint sensor detected!");
+	}
+
+	Checkpoint* hitCheckpoint = FindNearestCheckpoint(other);
+	if (!hitCheckpoint)
+		return;
+
+	if (progress && raceState == RACE_RUNNING)
+	{
+		AdvanceCarProgress(*progress, hitCheckpoint->order);
+	}
 
-	if (hitCheckpoint)
+	if (isPlayer)
 	{
-		LOG("Collided with checkpoint: %s", hitCheckpoint->name.c_str());
+		LOG_DBG("Collided with checkpoint: %s", hitCheckpoint->name.c_str());
 		ValidateCheckpointSequence(hitCheckpoint->order);
 	}
 }
 
+// Player (unless the race is AI-only) then NPCs
+void CheckpointManager::RegisterCars()
+{
+	carProgress.clear();
+	finishedCars = 0;
+
+	auto addCar = [this](PhysBody* body, const std::string& carName) {
+		if (!body) return;
+		CarProgress progress = { body, carName, 1, 1, 0, {}, 0, 0 };
+		carProgress.push_back(progress);
+
+		// One entry per lap - reserved now, so finishing a lap never allocates mid-race
+		carProgress.back().lapSteps.reserve(totalLaps);
+	};
+
+	if (!App->IsAIOnly())
+	{
+		addCar(playerBody, "Player");
+	}
+
+	if (App->npcManager)
+	{
+		const std::vector<Car*>& npcs = App->npcManager->GetNPCs();
+		for (size_t i = 0; i < npcs.size(); ++i)
+		{
+			if (npcs[i]) addCar(npcs[i]->GetPhysBody(), "NPC" + std::to_string(i + 1));
+		}
+	}
+}
+
+// Lap times count from the moment the race goes green
+void CheckpointManager::StartRaceClock()
+{
+	for (CarProgress& progress : carProgress)
+	{
+		progress.lapStartStep = App->GetSimulationStep();
+	}
+}
+
+// Same rules as the player's: checkpoints in order, then the finish line
+void CheckpointManager::AdvanceCarProgress(CarProgress& progress, int checkpointOrder)
+{
+	if (progress.place > 0 || checkpointOrder != progress.nextCheckpoint)
+		return;
+
+	if (checkpointOrder != 0)
+	{
+		progress.nextCheckpoint = (checkpointOrder >= totalCheckpoints) ? 0 : checkpointOrder + 1;
+		return;
+	}
+
+	uint64 step = App->GetSimulationStep();
+	progress.lapSteps.push_back(step - progress.lapStartStep);
+	progress.lapStartStep = step;
+
+	if (progress.lap >= totalLaps)
+	{
+		progress.place = ++finishedCars;
+		progress.finishStep = step;
+		LOG("%s finished in position %d (%.2fs)", progress.name.c_str(), progress.place, step * (double)FIXED_TIMESTEP);
+		return;
+	}
+
+	progress.lap++;
+	progress.nextCheckpoint = 1;
+}
+
 bool CheckpointManager::ValidateCheckpointSequence(int checkpointOrder)
 {
-	LOG("ValidateCheckpointSequence called with order: %d", checkpointOrder);
+	LOG_DBG("ValidateCheckpointSequence called with order: %d", checkpointOrder);
 
 	Checkpoint* checkpoint = nullptr;
 
@@ -603,16 +798,16 @@ bool CheckpointManager::ValidateCheckpointSequence(int checkpointOrder)
 
 	if (!checkpoint)
 	{
-		LOG("  -> ERROR: Checkpoint with order %d not found!", checkpointOrder);
+		LOG_ERR("  -> Checkpoint with order %d not found!", checkpointOrder);
 		return false;
 	}
 
-	LOG("  -> Found checkpoint: %s", checkpoint->name.c_str());
+	LOG_DBG("  -> Found checkpoint: %s", checkpoint->name.c_str());
 
 	// FINISH LINE logic (order == 0)
 	if (checkpoint->order == 0)
 	{
-		LOG("  -> This is the finish line");
+		LOG_DBG("  -> This is the finish line");
 
 		bool allCheckpointsCrossed = true;
 		for (const auto& cp : checkpoints)
@@ -620,7 +815,7 @@ bool CheckpointManager::ValidateCheckpointSequence(int checkpointOrder)
 			if (cp.order > 0 && !cp.crossed)
 			{
 				allCheckpointsCrossed = false;
-				LOG("  -> Missing checkpoint: %s", cp.name.c_str());
+				LOG_DBG("  -> Missing checkpoint: %s", cp.name.c_str());
 				break;
 			}
 		}
@@ -632,7 +827,7 @@ bool CheckpointManager::ValidateCheckpointSequence(int checkpointOrder)
 			// Play checkpoint.wav
 			if (App->audio && lapCompleteSfxId > 0)
 			{
-				App->audio->PlayFx(lapCompleteSfxId);
+				App->events->PostSound(lapCompleteSfxId);
 				LOG("Playing lap completion sound");
 			}
 
@@ -661,7 +856,7 @@ bool CheckpointManager::ValidateCheckpointSequence(int checkpointOrder)
 	}
 
 	// CHECKPOINT logic (order 1-5)
-	LOG("  -> Expected next checkpoint: %d", nextCheckpointOrder);
+	LOG_DBG("  -> Expected next checkpoint: %d", nextCheckpointOrder);
 
 	if (checkpoint->order == nextCheckpointOrder)
 	{
@@ -683,7 +878,7 @@ bool CheckpointManager::ValidateCheckpointSequence(int checkpointOrder)
 		}
 		else
 		{
-			LOG("  -> Checkpoint already crossed");
+			LOG_DBG("  -> Checkpoint already crossed");
 		}
 	}
 	else
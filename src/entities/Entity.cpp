@@ -45,6 +45,23 @@ void Entity::SetRotation(float degrees)
 	}
 }
 
+void Entity::GetRenderPosition(float& x, float& y) const
+{
+	if (physBody)
+	{
+		physBody->GetInterpolatedPositionF(app->GetInterpolationAlpha(), x, y);
+	}
+	else
+	{
+		x = y = 0.0f;
+	}
+}
+
+float Entity::GetRenderRotation() const
+{
+	return physBody ? physBody->GetInterpolatedRotation(app->GetInterpolationAlpha()) : 0.0f;
+}
+
 void Entity::SetActive(bool active)
 {
 	this->active = active;
@@ -2,44 +2,39 @@
 #include "core/Application.h"
 #include "core/Map.h"
 #include "entities/Car.h"
+#include "entities/CarStore.h"
 #include "entities/CheckpointManager.h"
 #include "modules/ModuleResources.h"
 #include "modules/ModulePhysics.h"
+#include "modules/ModuleRender.h"
 #include "core/p2Point.h"
 #include "entities/PushAbility.h"
 #include "entities/Player.h"
+#include "core/Trace.h"
+#include "core/JobSystem.h"
+#include "core/StateStream.h"
 #include "raylib.h"
 #include <cmath>
-#include <map>
 #include <string>
 #include <vector>
 #include <algorithm>
 
-// Structure to store radar ray sensor information
-struct RaySensor {
-    float angleOffset; // Degrees relative to car front (-45, 0, 45, etc.)
-    float distance;    // Detected distance
-    bool hit;          // Whether it hit something
-};
+// Fewest NPCs per job when sensing in parallel - one NPC's radar raycasts and terrain
+// sample are already worth a job of their own
+#define NPC_AI_MIN_GRAIN 1
 
-struct NPCState {
-    int targetIndex;
-    std::string stateName;
+// Every value NPCState::stateName takes, snapshots store its index
+#define NPC_STATE_NAME_COUNT 4
+static const char* const npcStateNames[NPC_STATE_NAME_COUNT] = { "INIT", "STUCK - REVERSE", "SEEKING GAP", "TIGHT CORNER" };
 
-    // For debug visualization
-    std::vector<RaySensor> sensors;
-    int bestRayIndex;
-
-    // Stuck detection
-    bool stuck;
-    float stuckTimer;
-    float reverseSteerDir;
-
-    // Ability usage detection
-    float lastAbilityCheck;  // Timer to avoid checking every frame
-};
-
-static std::map<Car*, NPCState> npcStates;
+static uint8_t GetStateNameIndex(const char* stateName)
+{
+    for (uint8_t i = 0; i < NPC_STATE_NAME_COUNT; ++i)
+    {
+        if (strcmp(npcStateNames[i], stateName) == 0) return i;
+    }
+    return 0;
+}
 
 NPCManager::NPCManager(Application* app, bool start_enabled)
 	: Module(app, start_enabled)
@@ -50,6 +45,13 @@ NPCManager::~NPCManager()
 {
 }
 
+// AI reads terrain, checkpoints and the player, abilities shove the player's car
+void NPCManager::DeclareAccess()
+{
+    Reads({ App->map, App->checkpointManager });
+    Writes({ App->physics, App->player, App->renderer });
+}
+
 bool NPCManager::Start()
 {
     LOG("Creating NPC cars");
@@ -74,8 +76,6 @@ bool NPCManager::Start()
         }
         npcCars.clear();
     }
-    // Clear NPC states map too
-    npcStates.clear();
 
     CreateNPC("NPC1", "assets/sprites/npc_1.png");
     CreateNPC("NPC2", "assets/sprites/npc_2.png");
@@ -94,14 +94,14 @@ bool NPCManager::Start()
         {
             delete ability;
             npcAbilities.push_back(nullptr);
-            LOG("WARNING: Failed to init ability for NPC%d", (int)i + 1);
+            LOG_WARN("Failed to init ability for NPC%d", (int)i + 1);
         }
     }
 
     return true;
 }
 
-update_status NPCManager::Update()
+update_status NPCManager::FixedUpdate(float dt)
 {
     // Don't update NPCs if race is finished
     if (App->checkpointManager && App->checkpointManager->IsRaceFinished())
@@ -111,6 +111,29 @@ update_status NPCManager::Update()
     if (App->checkpointManager && !App->checkpointManager->CanPlayerMove())
         return UPDATE_CONTINUE;
 
+    // States must exist before forking - the jobs below only look them up
+    for (size_t i = 0; i < npcCars.size(); i++)
+    {
+        if (npcCars[i]) InitAIState(npcCars[i], (int)i);
+    }
+
+    // Sense in parallel: terrain lookups and radar raycasts only read the map and
+    // the physics world, and each NPC writes nothing but its own state
+    // One chunk per thread, so even the stock three NPCs spread over the workers
+    int threads = App->jobs->GetWorkerCount() + 1;
+    int grain = MAX(NPC_AI_MIN_GRAIN, ((int)npcCars.size() + threads - 1) / threads);
+    App->jobs->ParallelFor((int)npcCars.size(), grain, [this, dt](int begin, int end) {
+        for (int i = begin; i < end; i++)
+        {
+            Car* npc = npcCars[i];
+            if (!npc) continue;
+
+            npc->SampleTerrain();
+            UpdateAI(npc, dt);
+        }
+    });
+
+    // Apply serially - forces, impulses and abilities touch Box2D and other cars
     for (size_t i = 0; i < npcCars.size(); i++)
     {
         Car* npc = npcCars[i];
@@ -118,20 +141,33 @@ update_status NPCManager::Update()
 
         if (npc)
         {
-            UpdateAI(npc);
+            ApplyAIInputs(npc);
             npc->Update();
 
             // Check and use ability
             if (ability)
             {
-                ability->Update();
-                CheckAndUseAbility(npc, ability);
+                ability->Update(dt);
+                CheckAndUseAbility(npc, ability, dt);
             }
         }
     }
     return UPDATE_CONTINUE;
 }
 
+update_status NPCManager::Update()
+{
+    if (App->checkpointManager && (App->checkpointManager->IsRaceFinished() || !App->checkpointManager->CanPlayerMove()))
+        return UPDATE_CONTINUE;
+
+    // Motor sounds once per rendered frame
+    for (Car* npc : npcCars)
+    {
+        if (npc) npc->UpdateMotorSound();
+    }
+    return UPDATE_CONTINUE;
+}
+
 // Helper: Detects only real static walls (not sensors)
 bool IsRealObstacle(PhysBody* body)
 {
@@ -139,25 +175,42 @@ bool IsRealObstacle(PhysBody* body)
     return body->IsStaticObstacle();
 }
 
-void NPCManager::UpdateAI(Car* npc)
+void NPCManager::InitAIState(Car* npc, int index)
 {
+    CarStore& cars = *App->cars;
+    CarId id = npc->GetCarId();
+    if (cars.hasAI[id]) return;
+
+    // Everything else (timers, inputs, stuck flags) starts at zero
+    NPCState& state = cars.ai[id];
+    state = NPCState{};
+    state.targetIndex = 1;
+    state.stateName = "INIT";
+    state.bestRayIndex = 2;
+
+    // Define 5 radar sensors (angles in degrees)
+    // Cover a wide fan to "see" tight corners
+    state.sensors[0] = { -60.0f, 0.0f, false }; // Far Left
+    state.sensors[1] = { -30.0f, 0.0f, false }; // Left Diagonal
+    state.sensors[2] = {   0.0f, 0.0f, false }; // Center
+    state.sensors[3] = {  30.0f, 0.0f, false }; // Right Diagonal
+    state.sensors[4] = {  60.0f, 0.0f, false }; // Far Right
+
+    // Streams follow the NPC's place in the grid, not its car id - ids are recycled in any order
+    state.random.Seed(App->GetRandomSeed(), RandomStreamId(RANDOM_STREAM_AI, (uint32_t)index));
+    cars.hasAI[id] = 1;
+}
+
+// Runs on job threads: reads the world, writes only this NPC's state
+void NPCManager::UpdateAI(Car* npc, float dt)
+{
+    TRACE_ZONE("NPCManager::UpdateAI");
+
     if (!npc || !App->checkpointManager) return;
 
-    // Initialize state
-    if (npcStates.find(npc) == npcStates.end()) {
-        npcStates[npc] = { 1, "INIT", {}, 2, false, 0.0f, 0.0f, 0.0f };
-        // Define 5 radar sensors (angles in degrees)
-        // Cover a wide fan to "see" tight corners
-        npcStates[npc].sensors = {
-            { -60.0f, 0.0f, false }, // Far Left
-            { -30.0f, 0.0f, false }, // Left Diagonal
-            {   0.0f, 0.0f, false }, // Center
-            {  30.0f, 0.0f, false }, // Right Diagonal
-            {  60.0f, 0.0f, false }  // Far Right
-        };
-    }
-    NPCState& state = npcStates[npc];
-    float dt = 1.0f / 60.0f;
+    CarId id = npc->GetCarId();
+    if (!App->cars->hasAI[id]) return;
+    NPCState& state = App->cars->ai[id];
 
     float npcX, npcY;
     npc->GetPosition(npcX, npcY);
@@ -188,8 +241,17 @@ void NPCManager::UpdateAI(Car* npc)
     PhysBody* hitBody;
     float hitX, hitY, nX, nY;
 
-    // Update all sensors
-    for (auto& sensor : state.sensors) {
+    // Update all sensors. Below full quality the diagonal rays keep their last reading
+    // for a few steps (staggered across NPCs); the center and far rays always recast
+    int diagonalInterval = App->GetQuality().diagonalSensorInterval;
+    bool recastDiagonals = diagonalInterval <= 1 || (App->GetSimulationStep() + id) % diagonalInterval == 0;
+
+    for (int i = 0; i < NPC_SENSOR_COUNT; i++) {
+        RaySensor& sensor = state.sensors[i];
+        bool diagonal = (i == 1 || i == 3);
+        bool neverCast = !sensor.hit && sensor.distance == 0.0f;
+        if (diagonal && !recastDiagonals && !neverCast) continue;
+
         float rayAngleRad = npcAngleRad + (sensor.angleOffset * (PI / 180.0f));
         vec2f dir = { cosf(rayAngleRad), sinf(rayAngleRad) };
         
@@ -223,7 +285,7 @@ void NPCManager::UpdateAI(Car* npc)
     float bestScore = -99999.0f;
     int bestIndex = 2; // Default center
 
-    for (int i = 0; i < (int)state.sensors.size(); i++) {
+    for (int i = 0; i < NPC_SENSOR_COUNT; i++) {
         float score = 0.0f;
         RaySensor& s = state.sensors[i];
 
@@ -267,8 +329,8 @@ void NPCManager::UpdateAI(Car* npc)
 
     if (state.stuckTimer > 2.0f && !state.stuck) {
         state.stuck = true;
-        // Invert escape direction
-        state.reverseSteerDir = (GetRandomValue(0, 1) == 0) ? 1.0f : -1.0f;
+        // Escape direction is picked on the main thread (the race RNG isn't thread-safe)
+        state.pickEscapeDir = true;
     }
 
     // --- 5. FINAL INPUTS ---
@@ -323,11 +385,29 @@ void NPCManager::UpdateAI(Car* npc)
         }
     }
 
+    state.steer = finalSteer;
+    state.accel = finalAccel;
+    state.brake = finalBrake;
+}
+
+void NPCManager::ApplyAIInputs(Car* npc)
+{
+    CarId id = npc->GetCarId();
+    if (!App->cars->hasAI[id]) return;
+    NPCState& state = App->cars->ai[id];
+
+    if (state.pickEscapeDir) {
+        // Invert escape direction
+        state.reverseSteerDir = (state.random.Range(0, 1) == 0) ? 1.0f : -1.0f;
+        state.steer = state.reverseSteerDir;
+        state.pickEscapeDir = false;
+    }
+
     // Aplicar
-    npc->Steer(finalSteer);
-    npc->Accelerate(finalAccel);
-    if (finalAccel < 0.0f) npc->Reverse(fabs(finalAccel));
-    if (finalBrake > 0.0f) npc->Brake(finalBrake);
+    npc->Steer(state.steer);
+    npc->Accelerate(state.accel);
+    if (state.accel < 0.0f) npc->Reverse(fabs(state.accel));
+    if (state.brake > 0.0f) npc->Brake(state.brake);
 }
 
 update_status NPCManager::PostUpdate()
@@ -347,17 +427,17 @@ update_status NPCManager::PostUpdate()
                 ability->Draw();
             }
 
-            if (App->physics->IsDebugMode() && npcStates.find(npc) != npcStates.end()) {
-                NPCState& state = npcStates[npc];
+            if (App->physics->IsDebugMode() && App->cars->hasAI[npc->GetCarId()]) {
+                const NPCState& state = App->cars->ai[npc->GetCarId()];
                 float x, y;
-                npc->GetPosition(x, y);
+                npc->GetRenderPosition(x, y);
 
-                float angle = npc->GetRotation();
+                float angle = npc->GetRenderRotation();
                 float angleRad = (angle - 90.0f) * (PI / 180.0f);
                 Vector2 center = { x, y };
 
-                for (int j = 0; j < (int)state.sensors.size(); j++) {
-                    RaySensor& s = state.sensors[j];
+                for (int j = 0; j < NPC_SENSOR_COUNT; j++) {
+                    const RaySensor& s = state.sensors[j];
                     float rayA = angleRad + s.angleOffset * (PI / 180.0f);
 
                     float visLen = s.distance;
@@ -393,17 +473,111 @@ bool NPCManager::CleanUp()
     for (Car* npc : npcCars) if (npc) delete npc;
     npcCars.clear();
 
-    npcStates.clear();
     return true;
 }
 
-void NPCManager::CheckAndUseAbility(Car* npc, PushAbility* ability)
+// Per NPC: car, AI state (with the sensor readings kept between recasts) and ability
+void NPCManager::SaveState(StateWriter& writer) const
+{
+    writer.Write((uint32_t)npcCars.size());
+
+    for (size_t i = 0; i < npcCars.size(); ++i)
+    {
+        Car* npc = npcCars[i];
+        npc->SaveState(writer);
+
+        CarId id = npc->GetCarId();
+        writer.Write(App->cars->hasAI[id] != 0);
+        if (App->cars->hasAI[id])
+        {
+            const NPCState& state = App->cars->ai[id];
+            writer.Write(state.targetIndex);
+            writer.Write(GetStateNameIndex(state.stateName));
+            writer.Write(state.bestRayIndex);
+            writer.Write(state.stuck);
+            writer.Write(state.stuckTimer);
+            writer.Write(state.reverseSteerDir);
+            writer.Write(state.lastAbilityCheck);
+            writer.Write(state.steer);
+            writer.Write(state.accel);
+            writer.Write(state.brake);
+            writer.Write(state.pickEscapeDir);
+            writer.Write(state.random);
+            for (const RaySensor& sensor : state.sensors)
+            {
+                writer.Write(sensor.distance);
+                writer.Write(sensor.hit);
+            }
+        }
+
+        PushAbility* ability = (i < npcAbilities.size()) ? npcAbilities[i] : nullptr;
+        writer.Write(ability != nullptr);
+        if (ability) ability->SaveState(writer);
+    }
+}
+
+bool NPCManager::LoadState(StateReader& reader)
+{
+    uint32_t count = 0;
+    if (!reader.Read(count) || count != npcCars.size())
+        return false;
+
+    for (size_t i = 0; i < npcCars.size(); ++i)
+    {
+        Car* npc = npcCars[i];
+        if (!npc->LoadState(reader))
+            return false;
+
+        bool hasState = false;
+        if (!reader.Read(hasState))
+            return false;
+        if (hasState)
+        {
+            // Sensor angles come from InitAIState, the rest from the snapshot
+            InitAIState(npc, (int)i);
+            NPCState& state = App->cars->ai[npc->GetCarId()];
+            reader.Read(state.targetIndex);
+            uint8_t nameIndex = 0;
+            reader.Read(nameIndex);
+            state.stateName = npcStateNames[nameIndex < NPC_STATE_NAME_COUNT ? nameIndex : 0];
+            reader.Read(state.bestRayIndex);
+            reader.Read(state.stuck);
+            reader.Read(state.stuckTimer);
+            reader.Read(state.reverseSteerDir);
+            reader.Read(state.lastAbilityCheck);
+            reader.Read(state.steer);
+            reader.Read(state.accel);
+            reader.Read(state.brake);
+            reader.Read(state.pickEscapeDir);
+            reader.Read(state.random);
+            for (RaySensor& sensor : state.sensors)
+            {
+                reader.Read(sensor.distance);
+                reader.Read(sensor.hit);
+            }
+        }
+        else
+        {
+            App->cars->hasAI[npc->GetCarId()] = 0;
+        }
+
+        PushAbility* ability = (i < npcAbilities.size()) ? npcAbilities[i] : nullptr;
+        bool hasAbility = false;
+        if (!reader.Read(hasAbility) || hasAbility != (ability != nullptr))
+            return false;
+        if (ability && !ability->LoadState(reader, npc))
+            return false;
+    }
+    return reader.IsValid();
+}
+
+void NPCManager::CheckAndUseAbility(Car* npc, PushAbility* ability, float dt)
 {
     if (!npc || !ability) return;
 
     // Check ability every 0.5 seconds (optimization)
-    NPCState& state = npcStates[npc];
-    state.lastAbilityCheck += GetFrameTime();
+    NPCState& state = App->cars->ai[npc->GetCarId()];
+    state.lastAbilityCheck += dt;
 
     if (state.lastAbilityCheck < 0.5f) return;
     state.lastAbilityCheck = 0.0f;
@@ -474,7 +648,7 @@ void NPCManager::CreateNPC(const char* npcName, const char* texturePath)
 	if (!npcCar->Start()) { delete npcCar; return; }
 
 	MapObject* startPos = nullptr;
-	for (const auto& object : App->map->mapData.objects) {
+	for (const auto& object : App->map->GetMapData().objects) {
 		if (object->name == "Start") {
 			Properties::Property* nameProp = object->properties.GetProperty("Name");
 			if (nameProp && nameProp->value == npcName) {
@@ -1,5 +1,6 @@
 #include "entities/PhysBody.h"
 #include "core/Globals.h"
+#include "core/StateStream.h"
 #include "box2d/box2d.h"
 
 // Physics constants
@@ -9,6 +10,7 @@
 #define RADIANS_TO_DEGREES (180.0f / b2_pi)
 
 PhysBody::PhysBody() : body(nullptr), userData(nullptr), collisionListener(nullptr)
+	, prevX(0.0f), prevY(0.0f), prevRotation(0.0f)
 {
 }
 
@@ -39,6 +41,9 @@ void PhysBody::SetPosition(float x, float y)
 {
 	if (!body) return;
 	body->SetTransform(b2Vec2(x * PIXELS_TO_METERS, y * PIXELS_TO_METERS), body->GetAngle());
+
+	// Teleport - don't interpolate from the old position
+	SavePreviousTransform();
 }
 
 float PhysBody::GetRotation() const
@@ -51,6 +56,99 @@ void PhysBody::SetRotation(float degrees)
 {
 	if (!body) return;
 	body->SetTransform(body->GetPosition(), degrees * DEGREES_TO_RADIANS);
+	SavePreviousTransform();
+}
+
+// === SNAPSHOT ===
+// Stored in Box2D units so a save/load round trip is exact
+void PhysBody::SaveState(StateWriter& writer) const
+{
+	b2Vec2 position(0.0f, 0.0f), velocity(0.0f, 0.0f);
+	float angle = 0.0f, angularVelocity = 0.0f;
+	bool awake = false, enabled = false;
+
+	if (body)
+	{
+		position = body->GetPosition();
+		angle = body->GetAngle();
+		velocity = body->GetLinearVelocity();
+		angularVelocity = body->GetAngularVelocity();
+		awake = body->IsAwake();
+		enabled = body->IsEnabled();
+	}
+
+	writer.Write(position);
+	writer.Write(angle);
+	writer.Write(velocity);
+	writer.Write(angularVelocity);
+	writer.Write(awake);
+	writer.Write(enabled);
+	writer.Write(prevX);
+	writer.Write(prevY);
+	writer.Write(prevRotation);
+}
+
+bool PhysBody::LoadState(StateReader& reader)
+{
+	b2Vec2 position, velocity;
+	float angle, angularVelocity;
+	bool awake, enabled;
+
+	reader.Read(position);
+	reader.Read(angle);
+	reader.Read(velocity);
+	reader.Read(angularVelocity);
+	reader.Read(awake);
+	reader.Read(enabled);
+	reader.Read(prevX);
+	reader.Read(prevY);
+	reader.Read(prevRotation);
+	if (!reader.IsValid())
+		return false;
+
+	if (body)
+	{
+		// Disabling drops the body's contacts and broadphase proxies: their touching state
+		// and warm-start impulses belong to the world before the load. Listeners restore
+		// their own state, so the contacts go without EndContact - overlaps that are still
+		// there report BeginContact again on the next step, and Box2D finds them afresh
+		b2World* world = body->GetWorld();
+		b2ContactListener* listener = world->GetContactManager().m_contactListener;
+		world->SetContactListener(nullptr);
+		body->SetEnabled(false);
+		world->SetContactListener(listener);
+
+		body->SetTransform(position, angle);
+		body->SetLinearVelocity(velocity);
+		body->SetAngularVelocity(angularVelocity);
+		body->SetEnabled(enabled);
+		body->SetAwake(awake);
+	}
+	return true;
+}
+
+// === INTERPOLATION ===
+void PhysBody::SavePreviousTransform()
+{
+	if (!body) return;
+	GetPositionF(prevX, prevY);
+	prevRotation = GetRotation();
+}
+
+void PhysBody::GetInterpolatedPositionF(float alpha, float& x, float& y) const
+{
+	if (!body) return;
+	float currentX, currentY;
+	GetPositionF(currentX, currentY);
+	x = prevX + (currentX - prevX) * alpha;
+	y = prevY + (currentY - prevY) * alpha;
+}
+
+float PhysBody::GetInterpolatedRotation(float alpha) const
+{
+	if (!body) return 0.0f;
+	// Box2D angles are continuous (not wrapped), so a straight lerp is safe
+	return prevRotation + (GetRotation() - prevRotation) * alpha;
 }
 
 // === VELOCITY ===
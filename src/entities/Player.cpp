@@ -8,6 +8,9 @@
 #include "modules/ModulePhysics.h"
 #include "modules/ModuleAudio.h"
 #include "modules/ModuleResources.h"
+#include "modules/ModuleRender.h"
+#include "core/StateStream.h"
+#include "core/EventBus.h"
 #include "raylib.h"
 
 ModulePlayer::ModulePlayer(Application* app, bool start_enabled)
@@ -15,6 +18,8 @@ ModulePlayer::ModulePlayer(Application* app, bool start_enabled)
 	, playerCar(nullptr)
 	, pushAbility(nullptr)
 	, carPassingSfxId(0)
+	, pushRequested(false)
+	, wasNPCNearby(false)
 {
 }
 
@@ -22,6 +27,13 @@ ModulePlayer::~ModulePlayer()
 {
 }
 
+// Terrain and race state are read, the push ability shoves NPC cars and shakes the camera
+void ModulePlayer::DeclareAccess()
+{
+	Reads({ App->map, App->checkpointManager, App->npcManager });
+	Writes({ App->physics, App->npcManager, App->renderer });
+}
+
 bool ModulePlayer::Start()
 {
 	LOG("Creating player car");
@@ -50,7 +62,7 @@ bool ModulePlayer::Start()
 	playerCar = new Car(App);
 	if (!playerCar->Start())
 	{
-		LOG("ERROR: Failed to create player car");
+		LOG_ERR("Failed to create player car");
 		return false;
 	}
 
@@ -60,7 +72,7 @@ bool ModulePlayer::Start()
 
 	// Find the Start object with Name property = "Player"
 	MapObject* startPos = nullptr;
-	for (const auto& object : App->map->mapData.objects)
+	for (const auto& object : App->map->GetMapData().objects)
 	{
 		if (object->name == "Start")
 		{
@@ -113,7 +125,7 @@ bool ModulePlayer::Start()
 	pushAbility = new PushAbility();
 	if (!pushAbility->Init(App, true))
 	{
-		LOG("ERROR: Failed to initialize push ability");
+		LOG_ERR("Failed to initialize push ability");
 		delete pushAbility;
 		pushAbility = nullptr;
 	}
@@ -128,17 +140,24 @@ bool ModulePlayer::Start()
 		}
 		else
 		{
-			LOG("WARNING: Failed to load car passing sound");
+			LOG_WARN("Failed to load car passing sound");
 		}
 	}
 
+	// AI-only races: keep the car (other modules expect it) but take it off the track
+	if (App->IsAIOnly() && playerCar->GetPhysBody())
+	{
+		playerCar->GetPhysBody()->SetActive(false);
+		LOG("AI-only race - player car parked");
+	}
+
 	LOG("Player car created successfully");
 	return true;
 }
 
-update_status ModulePlayer::Update()
+update_status ModulePlayer::FixedUpdate(float dt)
 {
-	if (!playerCar)
+	if (!playerCar || App->IsAIOnly())
 		return UPDATE_CONTINUE;
 
 	// Don't update if race is finished
@@ -158,9 +177,32 @@ update_status ModulePlayer::Update()
 	// Update push ability
 	if (pushAbility)
 	{
-		pushAbility->Update();
+		pushAbility->Update(dt);
+	}
+
+	return UPDATE_CONTINUE;
+}
+
+update_status ModulePlayer::Update()
+{
+	if (!playerCar)
+		return UPDATE_CONTINUE;
+
+	if (App->checkpointManager && (App->checkpointManager->IsRaceFinished() || !App->checkpointManager->CanPlayerMove()))
+	{
+		pushRequested = false;
+		return UPDATE_CONTINUE;
+	}
+
+	// Key presses only last one frame, so latch them until a simulation step runs
+	if (App->IsKeyPressed(KEY_SPACE))
+	{
+		pushRequested = true;
 	}
 
+	// Audio follows the rendered frame, not the simulation rate
+	playerCar->UpdateMotorSound();
+
 	// Check if NPCs are passing
 	CheckNPCPassing();
 
@@ -205,28 +247,95 @@ bool ModulePlayer::CleanUp()
 	return true;
 }
 
+void ModulePlayer::SaveState(StateWriter& writer) const
+{
+	writer.Write(playerCar != nullptr);
+	if (playerCar) playerCar->SaveState(writer);
+
+	writer.Write(pushAbility != nullptr);
+	if (pushAbility) pushAbility->SaveState(writer);
+
+	writer.Write(pushRequested);
+}
+
+bool ModulePlayer::LoadState(StateReader& reader)
+{
+	bool hasCar = false, hasAbility = false;
+
+	if (!reader.Read(hasCar) || hasCar != (playerCar != nullptr))
+		return false;
+	if (playerCar && !playerCar->LoadState(reader))
+		return false;
+
+	if (!reader.Read(hasAbility) || hasAbility != (pushAbility != nullptr))
+		return false;
+	if (pushAbility && !pushAbility->LoadState(reader, playerCar))
+		return false;
+
+	return reader.Read(pushRequested);
+}
+
 void ModulePlayer::HandleInput()
 {
 	if (!playerCar)
 		return;
 
+	InputRecorder& recorder = App->GetInputRecorder();
+
+	PlayerInput input = 0;
+	if (recorder.IsPlaying())
+	{
+		// The replay decides - drop any key press latched this frame
+		input = recorder.Next();
+		pushRequested = false;
+	}
+	else
+	{
+		input = SampleInput();
+		recorder.Record(input);
+	}
+
+	ApplyInput(input);
+}
+
+PlayerInput ModulePlayer::SampleInput()
+{
+	PlayerInput input = 0;
+
+	if (App->IsKeyDown(KEY_W) || App->IsKeyDown(KEY_UP)) input |= INPUT_ACCELERATE;
+	if (App->IsKeyDown(KEY_S) || App->IsKeyDown(KEY_DOWN)) input |= INPUT_REVERSE;
+	if (App->IsKeyDown(KEY_A) || App->IsKeyDown(KEY_LEFT)) input |= INPUT_STEER_LEFT;
+	if (App->IsKeyDown(KEY_D) || App->IsKeyDown(KEY_RIGHT)) input |= INPUT_STEER_RIGHT;
+
+	// Latched by Update, consumed by this step
+	if (pushRequested)
+	{
+		input |= INPUT_PUSH;
+		pushRequested = false;
+	}
+
+	return input;
+}
+
+void ModulePlayer::ApplyInput(PlayerInput input)
+{
 	// Acceleration (forward)
-	if (IsKeyDown(KEY_W) || IsKeyDown(KEY_UP))
+	if (input & INPUT_ACCELERATE)
 	{
 		playerCar->Accelerate(1.0f);
 	}
 	// Reverse
-	else if (IsKeyDown(KEY_S) || IsKeyDown(KEY_DOWN))
+	else if (input & INPUT_REVERSE)
 	{
 		playerCar->Reverse(1.0f);
 	}
 
 	// Steering
-	if (IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT))
+	if (input & INPUT_STEER_LEFT)
 	{
 		playerCar->Steer(-1.0f);
 	}
-	else if (IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT))
+	else if (input & INPUT_STEER_RIGHT)
 	{
 		playerCar->Steer(1.0f);
 	}
@@ -237,26 +346,21 @@ void ModulePlayer::HandleInput()
 	}
 
 	// PUSH ABILITY (replaces drift)
-	if (IsKeyPressed(KEY_SPACE))
+	if ((input & INPUT_PUSH) && pushAbility)
 	{
-		if (pushAbility)
-		{
-			float playerX, playerY;
-			playerCar->GetPosition(playerX, playerY);
+		float playerX, playerY;
+		playerCar->GetPosition(playerX, playerY);
 
-			// Get player rotation
-			float playerRotation = playerCar->GetRotation();
+		// Get player rotation
+		float playerRotation = playerCar->GetRotation();
 
-			// Activate ability with position, rotation AND the car that's using it
-			pushAbility->Activate(playerX, playerY, playerRotation, playerCar);
-		}
+		// Activate ability with position, rotation AND the car that's using it
+		pushAbility->Activate(playerX, playerY, playerRotation, playerCar);
 	}
 }
 
 void ModulePlayer::CheckNPCPassing()
 {
-	static bool wasNPCNearby = false;  // Track previous state
-
 	if (!playerCar || !App->npcManager || !App->audio)
 	{
 		return;
@@ -301,7 +405,7 @@ void ModulePlayer::CheckNPCPassing()
 	// Play sound when NPC enters range (edge detection)
 	if (npcPassingNearby && !wasNPCNearby)
 	{
-		App->audio->PlayFx(carPassingSfxId);
+		App->events->PostSound(carPassingSfxId);
 	}
 
 	wasNPCNearby = npcPassingNearby;
@@ -8,6 +8,8 @@
 #include "entities/PhysBody.h"
 #include "entities/Car.h"
 #include "core/p2Point.h"
+#include "core/StateStream.h"
+#include "core/EventBus.h"
 #include <cmath>
 
 // Ability configuration
@@ -53,11 +55,11 @@ bool PushAbility::Init(Application* application, bool isPlayerAbility)
 	app = application;
 	this->isPlayerAbility = isPlayerAbility;
 
+	// The effect is cosmetic - the ability still works without it (e.g. headless runs)
 	effectTexture = app->resources->LoadTexture("assets/sprites/space_effect.png");
-	if (effectTexture.id == 0)
+	if (effectTexture.id == 0 && !app->IsHeadless())
 	{
-		LOG("WARNING: Failed to load push ability effect texture");
-		return false;
+		LOG_WARN("Failed to load push ability effect texture");
 	}
 
 	if (app->audio)
@@ -94,7 +96,7 @@ void PushAbility::Activate(float playerX, float playerY, float rotation, Car* ac
 	// Play ability.wav
 	if (app && app->audio && abilitySfxId > 0)
 	{
-		app->audio->PlayFx(abilitySfxId);
+		app->events->PostSound(abilitySfxId);
 	}
 
 	active = true;
@@ -114,10 +116,8 @@ void PushAbility::Activate(float playerX, float playerY, float rotation, Car* ac
 	ApplyPushToNearbyNPCs();
 }
 
-void PushAbility::Update()
+void PushAbility::Update(float deltaTime)
 {
-	float deltaTime = GetFrameTime();
-
 	// Update cooldown
 	if (cooldownTimer < cooldownDuration)
 	{
@@ -129,7 +129,7 @@ void PushAbility::Update()
 			// Play cd_ability_down.wav (ONLY for player)
 			if (app && app->audio && cooldownReadySfxId > 0)
 			{
-				app->audio->PlayFx(cooldownReadySfxId);
+				app->events->PostSound(cooldownReadySfxId);
 				LOG("Player ability cooldown ready!");
 			}
 			wasCooldownReady = true;
@@ -208,6 +208,55 @@ float PushAbility::GetCooldownProgress() const
 	return cooldownTimer / cooldownDuration;
 }
 
+void PushAbility::SaveState(StateWriter& writer) const
+{
+	writer.Write(active);
+	writer.Write(activeTimer);
+	writer.Write(cooldownTimer);
+	writer.Write(wasCooldownReady);
+	writer.Write(centerX);
+	writer.Write(centerY);
+	writer.Write(playerRotation);
+	writer.Write(effectScale);
+	writer.Write(effectRotation);
+	writer.Write(activatingCar != nullptr);
+}
+
+bool PushAbility::LoadState(StateReader& reader, Car* owner)
+{
+	bool hasActivatingCar = false;
+
+	reader.Read(active);
+	reader.Read(activeTimer);
+	reader.Read(cooldownTimer);
+	reader.Read(wasCooldownReady);
+	reader.Read(centerX);
+	reader.Read(centerY);
+	reader.Read(playerRotation);
+	reader.Read(effectScale);
+	reader.Read(effectRotation);
+	reader.Read(hasActivatingCar);
+	if (!reader.IsValid())
+		return false;
+
+	// Abilities are only ever activated by the car that owns them
+	activatingCar = hasActivatingCar ? owner : nullptr;
+
+	if (!active)
+	{
+		DestroyPushSensor();
+	}
+	else if (pushSensor)
+	{
+		pushSensor->SetPosition(centerX, centerY);
+	}
+	else
+	{
+		CreatePushSensor();
+	}
+	return true;
+}
+
 void PushAbility::CreatePushSensor()
 {
 	if (!app || !app->physics)
@@ -217,7 +266,7 @@ void PushAbility::CreatePushSensor()
 	if (pushSensor)
 	{
 		pushSensor->SetSensor(true);
-		LOG("Push sensor created at (%.1f, %.1f) with radius %.1f", centerX, centerY, pushRadius);
+		LOG_DBG("Push sensor created at (%.1f, %.1f) with radius %.1f", centerX, centerY, pushRadius);
 	}
 }
 
@@ -238,29 +287,16 @@ void PushAbility::ApplyPushToNearbyNPCs()
 	float forceMult = 1.0f - (activeTimer / activeDuration);
 	forceMult = forceMult * forceMult;
 
-	std::vector<Car*> allCars;  // List of ALL cars (player + NPCs)
-
-	// Add player
-	if (app->player && app->player->GetCar())
-	{
-		allCars.push_back(app->player->GetCar());
-	}
-
-	// Add all NPCs
+	Car* playerCar = app->player ? app->player->GetCar() : nullptr;
 	const std::vector<Car*>& npcs = app->npcManager->GetNPCs();
-	for (Car* npc : npcs)
-	{
-		if (npc)
-		{
-			allCars.push_back(npc);
-		}
-	}
 
 	int pushedCount = 0;
 
-	// Push ALL nearby cars (player + NPCs)
-	for (Car* car : allCars)
+	// Push ALL nearby cars: index 0 is the player, then the NPCs
+	// Walked in place - this runs every step while the push is active
+	for (size_t i = 0; i <= npcs.size(); ++i)
 	{
+		Car* car = (i == 0) ? playerCar : npcs[i - 1];
 		if (!car || !car->GetPhysBody())
 			continue;
 
@@ -303,6 +339,6 @@ void PushAbility::ApplyPushToNearbyNPCs()
 
 	if (pushedCount > 0 && activeTimer < 0.1f)
 	{
-		LOG("Pushed %d cars (player + NPCs)", pushedCount);
+		LOG_DBG("Pushed %d cars (player + NPCs)", pushedCount);
 	}
 }
\ No newline at end of file
@@ -15,25 +15,71 @@ ModuleAudio::ModuleAudio(Application* app, bool start_enabled) : Module(app, sta
 
 ModuleAudio::~ModuleAudio()
 {
+	// Init failed elsewhere before anyone waited for the device
+	if (deviceThread.joinable())
+	{
+		deviceThread.join();
+	}
+}
+
+// Only its own streams - PlayFx and friends are locked, so callers needn't declare us
+void ModuleAudio::DeclareAccess()
+{
+	Writes({});
+}
+
+void ModuleAudio::Preload()
+{
+	OpenDevice();
 }
 
 bool ModuleAudio::Init()
 {
 	LOG("Initializing audio system");
-	InitAudioDevice();
 
-	if (!IsAudioDeviceReady())
+	// Normally already opening since Preload - nothing waits for it until the first sound
+	OpenDevice();
+	return true;
+}
+
+// The device doesn't need the window, so it opens while the window and intro start up
+void ModuleAudio::OpenDevice()
+{
+	std::lock_guard<std::mutex> lock(deviceMutex);
+	if (deviceStarted)
+		return;
+
+	deviceStarted = true;
+	deviceThread = std::thread([this]() {
+		InitAudioDevice();
+		deviceReady = IsAudioDeviceReady();
+	});
+}
+
+bool ModuleAudio::WaitForDevice()
+{
+	std::lock_guard<std::mutex> lock(deviceMutex);
+	if (deviceThread.joinable())
 	{
-		LOG("ERROR: Audio device failed to initialize!");
-		return false;
+		Timer timer;
+		deviceThread.join();
+
+		if (deviceReady)
+		{
+			LOG("Audio device initialized successfully (waited %.1f ms)", timer.ReadMs());
+		}
+		else
+		{
+			LOG_ERR("Audio device failed to initialize - running without sound");
+		}
 	}
-
-	LOG("Audio device initialized successfully");
-	return true;
+	return deviceReady;
 }
 
 update_status ModuleAudio::Update()
 {
+	std::lock_guard<std::mutex> lock(streamMutex);
+
 	// Update music stream every frame (required for music playback)
 	if (IsMusicValid(music))
 	{
@@ -54,17 +100,22 @@ bool ModuleAudio::CleanUp()
 	}
 
 	// Resources are cleaned up by ModuleResources automatically
-	CloseAudioDevice();
+	if (WaitForDevice())
+	{
+		CloseAudioDevice();
+	}
 	return true;
 }
 
 // Play music using the resource manager
 bool ModuleAudio::PlayMusic(const char* path, float fade_time)
 {
-	if (IsEnabled() == false)
+	MemoryScope memory(MEM_AUDIO);
+	if (IsEnabled() == false || !WaitForDevice())
 		return false;
 
 	bool ret = true;
+	std::lock_guard<std::mutex> lock(streamMutex);
 
 	// Stop current music if playing
 	if (IsMusicValid(music))
@@ -77,7 +128,7 @@ bool ModuleAudio::PlayMusic(const char* path, float fade_time)
 
 	if (!IsMusicValid(music))
 	{
-		LOG("ERROR: Could not load music: %s", path);
+		LOG_ERR("Could not load music: %s", path);
 		return false;
 	}
 
@@ -97,10 +148,12 @@ bool ModuleAudio::PlayMusic(const char* path, float fade_time)
 // Load WAV - now uses the resource manager
 unsigned int ModuleAudio::LoadFx(const char* path)
 {
-	if (IsEnabled() == false)
+	MemoryScope memory(MEM_AUDIO);
+	if (IsEnabled() == false || !WaitForDevice())
 		return 0;
 
 	unsigned int ret = 0;
+	std::lock_guard<std::mutex> lock(streamMutex);
 
 	// Load sound through resource manager
 	Sound sound = App->resources->LoadSound(path);
@@ -122,12 +175,14 @@ unsigned int ModuleAudio::LoadFx(const char* path)
 // Play WAV
 bool ModuleAudio::PlayFx(unsigned int id, int repeat)
 {
-	if (IsEnabled() == false)
+	MemoryScope memory(MEM_AUDIO);
+	if (IsEnabled() == false || !WaitForDevice())
 	{
 		return false;
 	}
 
 	bool ret = false;
+	std::lock_guard<std::mutex> lock(streamMutex);
 
 	// ID is 1-indexed, convert to 0-indexed array access
 	if (id > 0 && id <= fx_count)
@@ -9,6 +9,12 @@
 #include "entities/Car.h"
 #include "entities/CheckpointManager.h"
 
+// Decoded in the background by Preload, uploaded once the race starts
+#define GAME_BACKGROUND_PATH        "assets/ui/backgrounds/main_background.jpg"
+#define HUD_SPEEDOMETER_PATH        "assets/ui/hud/hud_speedometer.png"
+#define HUD_SPEEDOMETER_NEEDLE_PATH "assets/ui/hud/hud_speedometer_direction.png"
+#define HUD_LAP_COUNTER_PATH        "assets/ui/hud/hud_lap_counter.png"
+
 ModuleGame::ModuleGame(Application* app, bool start_enabled) : Module(app, start_enabled)
 {
 }
@@ -17,6 +23,19 @@ ModuleGame::~ModuleGame()
 {
 }
 
+void ModuleGame::DeclareAccess()
+{
+	Writes({});
+}
+
+void ModuleGame::Preload()
+{
+	App->resources->PreloadTexture(GAME_BACKGROUND_PATH);
+	App->resources->PreloadTexture(HUD_SPEEDOMETER_PATH);
+	App->resources->PreloadTexture(HUD_SPEEDOMETER_NEEDLE_PATH);
+	App->resources->PreloadTexture(HUD_LAP_COUNTER_PATH);
+}
+
 // Load assets
 bool ModuleGame::Start()
 {
@@ -37,7 +56,7 @@ void ModuleGame::LoadGameTextures()
 {
 	LOG("Loading game textures through resource manager...");
 
-	backgroundTexture = App->resources->LoadTexture("assets/ui/backgrounds/main_background.jpg");
+	backgroundTexture = App->resources->LoadTexture(GAME_BACKGROUND_PATH);
 	if (backgroundTexture.id != 0)
 	{
 		LOG("Main background loaded successfully for background rendering");
@@ -48,9 +67,9 @@ void ModuleGame::LoadGameTextures()
 	}
 
 	// Load HUD elements
-	speedometerTexture = App->resources->LoadTexture("assets/ui/hud/hud_speedometer.png");
-	speedometerNeedleTexture = App->resources->LoadTexture("assets/ui/hud/hud_speedometer_direction.png");
-	lapCounterTexture = App->resources->LoadTexture("assets/ui/hud/hud_lap_counter.png");
+	speedometerTexture = App->resources->LoadTexture(HUD_SPEEDOMETER_PATH);
+	speedometerNeedleTexture = App->resources->LoadTexture(HUD_SPEEDOMETER_NEEDLE_PATH);
+	lapCounterTexture = App->resources->LoadTexture(HUD_LAP_COUNTER_PATH);
 	
 	if (speedometerTexture.id != 0 && speedometerNeedleTexture.id != 0 && lapCounterTexture.id != 0)
 	{
@@ -68,6 +87,9 @@ void ModuleGame::RenderTiledBackground(bool screenSpace) const
 	if (backgroundTexture.id == 0)
 		return; // No background texture loaded
 
+	if (!App->GetQuality().backgroundTexture)
+		return; // Dropped by the quality governor, the clear color shows around the map
+
 	if (screenSpace)
 	{
 		// Render centered on screen (for full map view)
@@ -82,7 +104,7 @@ void ModuleGame::RenderTiledBackground(bool screenSpace) const
 		float cameraX = 0, cameraY = 0;
 		if (App && App->player && App->player->GetCar())
 		{
-			App->player->GetCar()->GetPosition(cameraX, cameraY);
+			App->player->GetCar()->GetRenderPosition(cameraX, cameraY);
 		}
 
 		Rectangle sourceRect = { 0, 0, (float)backgroundTexture.width, (float)backgroundTexture.height };
@@ -181,9 +203,16 @@ void ModuleGame::DrawHUD() const
 	int currentLap = App->checkpointManager->GetCurrentLap();
 	int totalLaps = App->checkpointManager->GetTotalLaps();
 	
-	const char* lapText = TextFormat("%d / %d", currentLap, totalLaps);
 	int lapFontSize = 24;  // Fixed font size
-	int lapTextWidth = MeasureText(lapText, lapFontSize);
+	if (currentLap != lapLabel.lap || totalLaps != lapLabel.totalLaps)
+	{
+		lapLabel.lap = currentLap;
+		lapLabel.totalLaps = totalLaps;
+		snprintf(lapLabel.text, sizeof(lapLabel.text), "%d / %d", currentLap, totalLaps);
+		lapLabel.width = MeasureText(lapLabel.text, lapFontSize);
+	}
+	const char* lapText = lapLabel.text;
+	int lapTextWidth = lapLabel.width;
 	
 	// The visible blue box is at the TOP-LEFT of the texture
 	// Based on screenshot: box starts near top and is roughly 40% width, 20% height
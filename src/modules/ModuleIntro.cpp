@@ -4,6 +4,8 @@
 #include "modules/ModuleMainMenu.h"
 #include "raylib.h"
 
+#define LOGO_TEXTURE_PATH "assets/ui/intro/logo.png"
+
 ModuleIntro::ModuleIntro(Application* app, bool start_enabled) 
     : Module(app, start_enabled),
     m_phase(IntroPhase::CompanyLogo),
@@ -17,6 +19,11 @@ ModuleIntro::~ModuleIntro()
 {
 }
 
+void ModuleIntro::Preload()
+{
+    App->resources->PreloadTexture(LOGO_TEXTURE_PATH);
+}
+
 bool ModuleIntro::Start()
 {
     LOG("Intro module started");
@@ -24,7 +31,7 @@ bool ModuleIntro::Start()
     m_alpha = 0.0f;
     m_timer = 0.0f;
     
-    logoTexture = App->resources->LoadTexture("assets/ui/intro/logo.png");
+    logoTexture = App->resources->LoadTexture(LOGO_TEXTURE_PATH);
     
     return true;
 }
@@ -36,10 +43,10 @@ update_status ModuleIntro::Update()
         return UPDATE_CONTINUE;
     }
 
-    float deltaTime = GetFrameTime();
+    float deltaTime = App->GetFrameDelta();
     
     // Allow skipping with SPACE or ENTER
-    if (IsKeyPressed(KEY_SPACE) || IsKeyPressed(KEY_ENTER))
+    if (App->IsKeyPressed(KEY_SPACE) || App->IsKeyPressed(KEY_ENTER))
     {
         m_phase = IntroPhase::Done;
         this->Disable();
@@ -86,6 +93,11 @@ void ModuleIntro::UpdateFade(float deltaTime)
     }
 }
 
+bool ModuleIntro::IsIdle() const
+{
+    return m_phase == IntroPhase::CompanyLogo && m_timer >= FADE_IN_TIME && m_timer < FADE_IN_TIME + HOLD_TIME;
+}
+
 update_status ModuleIntro::PostUpdate()
 {
     if (m_phase == IntroPhase::Done)
@@ -10,6 +10,21 @@
 #include "entities/CheckpointManager.h"
 #include "raylib.h"
 
+// Menu textures - decoded in the background by Preload, uploaded by Start
+#define MENU_BACKGROUND_PATH           "assets/ui/backgrounds/main_menu_background.jpg"
+#define MENU_SECONDARY_BACKGROUND_PATH "assets/ui/backgrounds/second_background.png"
+#define MENU_TITLE_PATH                "assets/ui/hud/main_menu_title.png"
+#define MENU_START_PATH                "assets/ui/hud/main_menu_start.png"
+#define MENU_OPTIONS_PATH              "assets/ui/hud/main_menu_options.png"
+#define MENU_CREDITS_PATH              "assets/ui/hud/main_menu_credits.png"
+#define MENU_START_SELECTED_PATH       "assets/ui/hud/main_menu_start_selected.png"
+#define MENU_OPTIONS_SELECTED_PATH     "assets/ui/hud/main_menu_options_selected.png"
+#define MENU_CREDITS_SELECTED_PATH     "assets/ui/hud/main_menu_credits_selected.png"
+#define MENU_SELECTING_PATH            "assets/ui/hud/main_menu_selecting.png"
+
+// Seconds without a change before the menu counts as idle - keeps browsing at the full rate
+#define MENU_IDLE_DELAY 1.0f
+
 ModuleMainMenu::ModuleMainMenu(Application* app, bool start_enabled) : Module(app, start_enabled)
 {
     LOG("Main menu constructor");
@@ -20,32 +35,55 @@ ModuleMainMenu::~ModuleMainMenu()
 {
 }
 
+void ModuleMainMenu::Preload()
+{
+    App->resources->PreloadTexture(MENU_BACKGROUND_PATH);
+    App->resources->PreloadTexture(MENU_SECONDARY_BACKGROUND_PATH);
+    App->resources->PreloadTexture(MENU_TITLE_PATH);
+    App->resources->PreloadTexture(MENU_START_PATH);
+    App->resources->PreloadTexture(MENU_OPTIONS_PATH);
+    App->resources->PreloadTexture(MENU_CREDITS_PATH);
+    App->resources->PreloadTexture(MENU_START_SELECTED_PATH);
+    App->resources->PreloadTexture(MENU_OPTIONS_SELECTED_PATH);
+    App->resources->PreloadTexture(MENU_CREDITS_SELECTED_PATH);
+    App->resources->PreloadTexture(MENU_SELECTING_PATH);
+}
+
 bool ModuleMainMenu::Start()
 {
     LOG("Main menu started");
     currentState = STATE_MAIN;
     currentSelection = START;
-    backgroundTexture = App->resources->LoadTexture("assets/ui/backgrounds/main_menu_background.jpg");
-    secondaryBackground = App->resources->LoadTexture("assets/ui/backgrounds/second_background.png");
-    titleTexture = App->resources->LoadTexture("assets/ui/hud/main_menu_title.png");
+    backgroundTexture = App->resources->LoadTexture(MENU_BACKGROUND_PATH);
+    secondaryBackground = App->resources->LoadTexture(MENU_SECONDARY_BACKGROUND_PATH);
+    titleTexture = App->resources->LoadTexture(MENU_TITLE_PATH);
     
     // Load non-selected button textures (always visible)
-    buttonTextures[START] = App->resources->LoadTexture("assets/ui/hud/main_menu_start.png");
-    buttonTextures[OPTIONS] = App->resources->LoadTexture("assets/ui/hud/main_menu_options.png");
-    buttonTextures[CREDITS] = App->resources->LoadTexture("assets/ui/hud/main_menu_credits.png");
+    buttonTextures[START] = App->resources->LoadTexture(MENU_START_PATH);
+    buttonTextures[OPTIONS] = App->resources->LoadTexture(MENU_OPTIONS_PATH);
+    buttonTextures[CREDITS] = App->resources->LoadTexture(MENU_CREDITS_PATH);
     
     // Load selected button textures (shown when option is highlighted)
-    buttonSelectedTextures[START] = App->resources->LoadTexture("assets/ui/hud/main_menu_start_selected.png");
-    buttonSelectedTextures[OPTIONS] = App->resources->LoadTexture("assets/ui/hud/main_menu_options_selected.png");
-    buttonSelectedTextures[CREDITS] = App->resources->LoadTexture("assets/ui/hud/main_menu_credits_selected.png");
+    buttonSelectedTextures[START] = App->resources->LoadTexture(MENU_START_SELECTED_PATH);
+    buttonSelectedTextures[OPTIONS] = App->resources->LoadTexture(MENU_OPTIONS_SELECTED_PATH);
+    buttonSelectedTextures[CREDITS] = App->resources->LoadTexture(MENU_CREDITS_SELECTED_PATH);
     
-    selectingTexture = App->resources->LoadTexture("assets/ui/hud/main_menu_selecting.png");
+    selectingTexture = App->resources->LoadTexture(MENU_SELECTING_PATH);
 
     // Load menu sound effects
     selectSfx = App->audio->LoadFx("assets/audio/fx/checkpoint.wav");
 
     // Play main menu music
     App->audio->PlayMusic("assets/audio/music/main_menu_music.mp3");
+
+    // Without a render texture the menu is simply drawn every frame
+    menuFrame = LoadRenderTexture(SCREEN_WIDTH, SCREEN_HEIGHT);
+    if (!IsRenderTextureValid(menuFrame))
+    {
+        LOG_WARN("Main menu: no render texture, the menu won't be cached");
+    }
+    menuFrameValid = false;
+    idleTime = 0.0f;
     
     return true;
 }
@@ -55,40 +93,28 @@ update_status ModuleMainMenu::Update()
     switch (currentState)
     {
     case STATE_MAIN:
-        if (IsKeyPressed(KEY_DOWN))
+        // Escape quits from the main menu (in a race it comes back here)
+        if (App->IsKeyPressed(KEY_ESCAPE))
+        {
+            LOG("Quitting from main menu");
+            return UPDATE_STOP;
+        }
+        if (App->IsKeyPressed(KEY_DOWN))
         {
             currentSelection = (MenuOption)((currentSelection + 1) % COUNT);
         }
-        if (IsKeyPressed(KEY_UP))
+        if (App->IsKeyPressed(KEY_UP))
         {
             currentSelection = (MenuOption)((currentSelection - 1 + COUNT) % COUNT);
         }
-        if (IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_SPACE))
+        if (App->IsKeyPressed(KEY_ENTER) || App->IsKeyPressed(KEY_SPACE))
         {
             App->audio->PlayFx(selectSfx);
             
             if (currentSelection == START)
             {
                 LOG("Starting game from menu");
-                App->state = GAME_PLAYING;
-                
-                // CRITICAL: Enable in correct order!
-                // 1. Map FIRST - loads positions and collision data
-                App->map->Enable();
-                
-                // 2. Physics SECOND - creates world for bodies
-                App->physics->Enable();
-                
-                // 3. Game scene
-                App->scene_intro->Enable();
-                
-                // 4. Player and NPCs - need map positions!
-                App->player->Enable();
-                App->npcManager->Enable();
-                
-                // 5. Checkpoint manager - needs player reference
-                App->checkpointManager->Enable();
-                
+                App->StartRace();
                 this->Disable();
             }
             else if (currentSelection == OPTIONS)
@@ -107,7 +133,7 @@ update_status ModuleMainMenu::Update()
     case STATE_OPTIONS:
     case STATE_CREDITS:
         // Press ESC or BACKSPACE to return to main menu
-        if (IsKeyPressed(KEY_ESCAPE) || IsKeyPressed(KEY_BACKSPACE))
+        if (App->IsKeyPressed(KEY_ESCAPE) || App->IsKeyPressed(KEY_BACKSPACE))
         {
             LOG("Returning to main menu");
             currentState = STATE_MAIN;
@@ -119,6 +145,43 @@ update_status ModuleMainMenu::Update()
 }
 
 update_status ModuleMainMenu::PostUpdate()
+{
+    if (!IsRenderTextureValid(menuFrame))
+    {
+        DrawMenuScreen();
+        return UPDATE_CONTINUE;
+    }
+
+    // Compose the screen again only when it shows something else - every other frame is one copy
+    if (!menuFrameValid || currentState != drawnState || currentSelection != drawnSelection)
+    {
+        BeginTextureMode(menuFrame);
+        ClearBackground(BLACK);
+        DrawMenuScreen();
+        EndTextureMode();
+
+        menuFrameValid = true;
+        drawnState = currentState;
+        drawnSelection = currentSelection;
+        idleTime = 0.0f;
+    }
+    else
+    {
+        idleTime += App->GetFrameDelta();
+    }
+
+    // Render textures are stored upside down, flip while copying
+    Rectangle source = {0, 0, (float)menuFrame.texture.width, -(float)menuFrame.texture.height};
+    DrawTextureRec(menuFrame.texture, source, Vector2{0, 0}, WHITE);
+    return UPDATE_CONTINUE;
+}
+
+bool ModuleMainMenu::IsIdle() const
+{
+    return menuFrameValid && idleTime >= MENU_IDLE_DELAY;
+}
+
+void ModuleMainMenu::DrawMenuScreen()
 {
     switch (currentState)
     {
@@ -132,7 +195,6 @@ update_status ModuleMainMenu::PostUpdate()
         DrawCreditsMenu();
         break;
     }
-    return UPDATE_CONTINUE;
 }
 
 void ModuleMainMenu::DrawMainMenu()
@@ -206,7 +268,7 @@ void ModuleMainMenu::DrawOptionsMenu()
         {"Change Camera", "C"},
         {"Push Ability", "Space"},
         {"Toggle Debug", "F1"},
-        {"Pause", "P"},
+        {"Restart Race", "R"},
         {"Back / Menu", "Escape"}
     };
 
@@ -331,6 +393,12 @@ void ModuleMainMenu::DrawCreditsMenu()
 bool ModuleMainMenu::CleanUp()
 {
     currentState = STATE_MAIN;
+    if (IsRenderTextureValid(menuFrame))
+    {
+        UnloadRenderTexture(menuFrame);
+    }
+    menuFrame = {};
+    menuFrameValid = false;
     App->resources->UnloadTexture("assets/ui/backgrounds/main_menu_background.jpg");
     App->resources->UnloadTexture("assets/ui/backgrounds/second_background.png");
     App->resources->UnloadTexture("assets/ui/hud/main_menu_title.png");
@@ -8,21 +8,25 @@
 #include "entities/Entity.h"
 #include "entities/CheckpointManager.h"
 #include "entities/PushAbility.h"
+#include "core/Trace.h"
+#include "core/Timer.h"
+#include "core/EventBus.h"
 
 #include "box2d/box2d.h"
 #include "box2d/b2_mouse_joint.h"
 #include "raylib.h"
 #include <math.h>
+#include <algorithm>
 
 // Physics constants
 #define METERS_TO_PIXELS 50.0f
 #define PIXELS_TO_METERS (1.0f / METERS_TO_PIXELS)
 #define GRAVITY_X 0.0f
 #define GRAVITY_Y 10.0f  // 10 m/s^2 downward
-#define VELOCITY_ITERATIONS 8
-#define POSITION_ITERATIONS 3
+#define PROFILER_OVERLAY_ROWS 10  // Worst module phases shown in the F1 overlay
 
 // Contact listener for collision callbacks
+// Listeners are only queued here - they run after the step (EventBus::DispatchContacts)
 class ModulePhysics::PhysicsContactListener : public b2ContactListener
 {
 private:
@@ -36,12 +40,9 @@ void BeginContact(b2Contact* contact) override
 		PhysBody* bodyA = (PhysBody*)contact->GetFixtureA()->GetBody()->GetUserData().pointer;
 		PhysBody* bodyB = (PhysBody*)contact->GetFixtureB()->GetBody()->GetUserData().pointer;
 		
-		// Call listeners
-		if (bodyA && bodyA->GetCollisionListener())
-			bodyA->GetCollisionListener()->OnCollisionEnter(bodyB);
-		
-		if (bodyB && bodyB->GetCollisionListener())
-			bodyB->GetCollisionListener()->OnCollisionEnter(bodyA);
+		// Queue listeners
+		if (physicsModule && ((bodyA && bodyA->GetCollisionListener()) || (bodyB && bodyB->GetCollisionListener())))
+			physicsModule->App->events->PostContact(bodyA, bodyB, true);
 		
 		// Do NOT record SENSORS in the visual collision list (HUD)
 		if (contact->GetFixtureA()->IsSensor() || contact->GetFixtureB()->IsSensor())
@@ -74,11 +75,8 @@ void BeginContact(b2Contact* contact) override
 		PhysBody* bodyA = (PhysBody*)contact->GetFixtureA()->GetBody()->GetUserData().pointer;
 		PhysBody* bodyB = (PhysBody*)contact->GetFixtureB()->GetBody()->GetUserData().pointer;
 		
-		if (bodyA && bodyA->GetCollisionListener())
-			bodyA->GetCollisionListener()->OnCollisionExit(bodyB);
-		
-		if (bodyB && bodyB->GetCollisionListener())
-			bodyB->GetCollisionListener()->OnCollisionExit(bodyA);
+		if (physicsModule && ((bodyA && bodyA->GetCollisionListener()) || (bodyB && bodyB->GetCollisionListener())))
+			physicsModule->App->events->PostContact(bodyA, bodyB, false);
 	}
 };
 
@@ -106,7 +104,7 @@ bool ModulePhysics::Init()
 	
 	if (!world)
 	{
-		LOG("ERROR: Failed to create Box2D world");
+		LOG_ERR("Failed to create Box2D world");
 		return false;
 	}
 	
@@ -136,7 +134,7 @@ bool ModulePhysics::Start()
 		
 		if (!world)
 		{
-			LOG("ERROR: Failed to recreate Box2D world");
+			LOG_ERR("Failed to recreate Box2D world");
 			return false;
 		}
 		
@@ -160,21 +158,46 @@ update_status ModulePhysics::PreUpdate()
 	if (!world)
 		return UPDATE_CONTINUE;
 	
-	// Clear previous collision data
-	activeCollisions.clear();
-	
-	// Step the physics simulation
-	float timeStep = 1.0f / 60.0f;
-	world->Step(timeStep, VELOCITY_ITERATIONS, POSITION_ITERATIONS);
+	// Clear previous frame's collision data (steps of this frame append to it)
 	activeCollisions.clear();
 	
 	return UPDATE_CONTINUE;
 }
 
+update_status ModulePhysics::FixedUpdate(float dt)
+{
+	if (!world)
+		return UPDATE_CONTINUE;
+
+	// Remember where moving bodies were so rendering can interpolate this step
+	for (PhysBody* body : bodies)
+	{
+		b2Body* b2body = body->GetB2Body();
+		if (b2body && b2body->GetType() != b2_staticBody)
+		{
+			body->SavePreviousTransform();
+		}
+	}
+
+	// Step the physics simulation - solver iterations come from the quality level
+	const QualitySettings& quality = App->GetQuality();
+	TRACE_BEGIN("b2World::Step");
+	world->Step(dt, quality.velocityIterations, quality.positionIterations);
+	TRACE_END();
+
+	// Cars read their transform and velocity from the store until the next step
+	App->cars->SyncFromBodies();
+
+	// Collision listeners see the world after the step, in Box2D's callback order
+	App->events->DispatchContacts();
+
+	return UPDATE_CONTINUE;
+}
+
 update_status ModulePhysics::PostUpdate()
 {
 	// Toggle debug mode with F1
-	if (IsKeyPressed(KEY_F1))
+	if (App->IsKeyPressed(KEY_F1))
 	{
 		debugMode = !debugMode;
 		LOG("Physics debug mode: %s", debugMode ? "ON" : "OFF");
@@ -193,6 +216,9 @@ bool ModulePhysics::CleanUp()
 {
 	LOG("Destroying physics world");
 	
+	// Queued contacts point at the bodies below
+	App->events->Clear();
+
 	// Destroy all physics bodies
 	for (PhysBody* body : bodies)
 	{
@@ -235,9 +261,10 @@ bool ModulePhysics::CleanUp()
 // Body creation methods
 PhysBody* ModulePhysics::CreateCircle(float x, float y, float radius, PhysBody::BodyType bodyType)
 {
+	MemoryScope memory(MEM_PHYSICS);
 	if (!world)
 	{
-		LOG("ERROR: Cannot create circle - world not initialized");
+		LOG_ERR("Cannot create circle - world not initialized");
 		return nullptr;
 	}
 	
@@ -267,17 +294,19 @@ PhysBody* ModulePhysics::CreateCircle(float x, float y, float radius, PhysBody::
 	PhysBody* physBody = new PhysBody();
 	physBody->SetB2Body(b2body);
 	b2body->GetUserData().pointer = (uintptr_t)physBody;
+	physBody->SavePreviousTransform();
 	bodies.push_back(physBody);
 	
-	LOG("Created circle body at (%.1f, %.1f) with radius %.1f", x, y, radius);
+	LOG_DBG("Created circle body at (%.1f, %.1f) with radius %.1f", x, y, radius);
 	return physBody;
 }
 
 PhysBody* ModulePhysics::CreateRectangle(float x, float y, float width, float height, PhysBody::BodyType bodyType)
 {
+	MemoryScope memory(MEM_PHYSICS);
 	if (!world)
 	{
-		LOG("ERROR: Cannot create rectangle - world not initialized");
+		LOG_ERR("Cannot create rectangle - world not initialized");
 		return nullptr;
 	}
 	
@@ -307,17 +336,19 @@ PhysBody* ModulePhysics::CreateRectangle(float x, float y, float width, float he
 	PhysBody* physBody = new PhysBody();
 	physBody->SetB2Body(b2body);
 	b2body->GetUserData().pointer = (uintptr_t)physBody;
+	physBody->SavePreviousTransform();
 	bodies.push_back(physBody);
 	
-	LOG("Created rectangle body at (%.1f, %.1f) with size %.1fx%.1f", x, y, width, height);
+	LOG_DBG("Created rectangle body at (%.1f, %.1f) with size %.1fx%.1f", x, y, width, height);
 	return physBody;
 }
 
 PhysBody* ModulePhysics::CreatePolygon(float x, float y, const float* vertices, int vertexCount, PhysBody::BodyType bodyType)
 {
+	MemoryScope memory(MEM_PHYSICS);
 	if (!world || !vertices || vertexCount < 3 || vertexCount > b2_maxPolygonVertices)
 	{
-		LOG("ERROR: Invalid polygon parameters");
+		LOG_ERR("Invalid polygon parameters");
 		return nullptr;
 	}
 	
@@ -355,17 +386,19 @@ PhysBody* ModulePhysics::CreatePolygon(float x, float y, const float* vertices,
 	PhysBody* physBody = new PhysBody();
 	physBody->SetB2Body(b2body);
 	b2body->GetUserData().pointer = (uintptr_t)physBody;
+	physBody->SavePreviousTransform();
 	bodies.push_back(physBody);
 	
-	LOG("Created polygon body at (%.1f, %.1f) with %d vertices", x, y, vertexCount);
+	LOG_DBG("Created polygon body at (%.1f, %.1f) with %d vertices", x, y, vertexCount);
 	return physBody;
 }
 
 PhysBody* ModulePhysics::CreateChain(float x, float y, const float* vertices, int vertexCount, bool loop)
 {
+    MemoryScope memory(MEM_PHYSICS);
     if (!world || !vertices || vertexCount < 2)
     {
-        LOG("ERROR: Invalid chain parameters");
+        LOG_ERR("Invalid chain parameters");
         return nullptr;
     }
 
@@ -412,9 +445,10 @@ PhysBody* ModulePhysics::CreateChain(float x, float y, const float* vertices, in
     PhysBody* physBody = new PhysBody();
     physBody->SetB2Body(b2body);
     b2body->GetUserData().pointer = (uintptr_t)physBody;
+    physBody->SavePreviousTransform();
     bodies.push_back(physBody);
     
-    LOG("Created chain/edge body at (%.1f, %.1f) with %d vertices (loop: %s)", x, y, vertexCount, loop ? "yes" : "no");
+    LOG_DBG("Created chain/edge body at (%.1f, %.1f) with %d vertices (loop: %s)", x, y, vertexCount, loop ? "yes" : "no");
     return physBody;
 }
 
@@ -424,6 +458,9 @@ void ModulePhysics::DestroyBody(PhysBody* body)
 	
 	b2Body* b2body = body->GetB2Body();
 	if (b2body) world->DestroyBody(b2body);
+
+	// Destroying ends the body's contacts - those events must not outlive it
+	App->events->PurgeBody(body);
 	
 	for (auto it = bodies.begin(); it != bodies.end(); ++it)
 	{
@@ -490,6 +527,9 @@ float ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& norma
 
 bool ModulePhysics::Raycast(float x1, float y1, float x2, float y2, PhysBody*& hitBody, float& hitX, float& hitY, float& hitNormalX, float& hitNormalY)
 {
+	// Called by every NPC sensor on every step - too short and frequent for a trace zone
+	SCOPED_TIMER("ModulePhysics::Raycast");
+
 	if (!world) return false;
 	
 	b2Vec2 start(x1 * PIXELS_TO_METERS, y1 * PIXELS_TO_METERS);
@@ -541,6 +581,9 @@ void ModulePhysics::DebugDraw()
 {
 	if (!world) return;
 
+	// Sensors are outlined three times over so they stand out - only at full quality
+	bool thickSensors = App->GetQuality().thickDebugLines;
+
 	for (b2Body* b = world->GetBodyList(); b; b = b->GetNext())
 	{
 		for (b2Fixture* f = b->GetFixtureList(); f; f = f->GetNext())
@@ -567,7 +610,7 @@ void ModulePhysics::DebugDraw()
 				float py = pos.y * METERS_TO_PIXELS;
 				float radius = shape->m_radius * METERS_TO_PIXELS;
 				DrawCircleLines((int)px, (int)py, radius, color);
-				if (f->IsSensor()) DrawCircleLines((int)px, (int)py, radius - 1, color);
+				if (thickSensors && f->IsSensor()) DrawCircleLines((int)px, (int)py, radius - 1, color);
 				DrawLine((int)px - 5, (int)py, (int)px + 5, (int)py, YELLOW);
 				DrawLine((int)px, (int)py - 5, (int)px, (int)py + 5, YELLOW);
 			}
@@ -587,7 +630,7 @@ void ModulePhysics::DebugDraw()
 						float x2 = v.x * METERS_TO_PIXELS;
 						float y2 = v.y * METERS_TO_PIXELS;
 						DrawLine((int)x1, (int)y1, (int)x2, (int)y2, color);
-						if (f->IsSensor()) {
+						if (thickSensors && f->IsSensor()) {
 							DrawLine((int)x1 + 1, (int)y1, (int)x2 + 1, (int)y2, color);
 							DrawLine((int)x1, (int)y1 + 1, (int)x2, (int)y2 + 1, color);
 						}
@@ -600,7 +643,7 @@ void ModulePhysics::DebugDraw()
 				float x2 = v.x * METERS_TO_PIXELS;
 				float y2 = v.y * METERS_TO_PIXELS;
 				DrawLine((int)x1, (int)y1, (int)x2, (int)y2, color);
-				if (f->IsSensor()) {
+				if (thickSensors && f->IsSensor()) {
 					DrawLine((int)x1 + 1, (int)y1, (int)x2 + 1, (int)y2, color);
 					DrawLine((int)x1, (int)y1 + 1, (int)x2, (int)y2 + 1, color);
 				}
@@ -672,7 +715,7 @@ void ModulePhysics::RenderDebug()
 	DrawRectangleLines(overlayX, overlayY, overlayW, overlayH, YELLOW);
 
 	// FPS
-	int fps = GetFPS();
+	int fps = (int)App->GetFramesLastSecond();
 	DrawText(TextFormat("FPS: %d", fps), overlayX + 10, overlayY + 10, 22, WHITE);
 
 	// Body count
@@ -689,7 +732,7 @@ void ModulePhysics::RenderDebug()
 	DrawText(TextFormat("Gravity: (%.2f, %.2f)", gravity.x, gravity.y), overlayX + 10, overlayY + 65, 20, WHITE);
 
 	// Step info
-	DrawText(TextFormat("Step: dt=1/60, VelIters=%d, PosIters=%d", VELOCITY_ITERATIONS, POSITION_ITERATIONS), overlayX + 10, overlayY + 90, 18, WHITE);
+	DrawText(TextFormat("Step: dt=1/%.0f x%d, VelIters=%d, PosIters=%d", 1.0f / FIXED_TIMESTEP, App->GetTimeScale(), App->GetQuality().velocityIterations, App->GetQuality().positionIterations), overlayX + 10, overlayY + 90, 18, WHITE);
 
 	// World size
 	DrawText(TextFormat("World: %dx%d px", SCREEN_WIDTH, SCREEN_HEIGHT), overlayX + 10, overlayY + 110, 18, WHITE);
@@ -758,6 +801,92 @@ void ModulePhysics::RenderDebug()
 		// Text
 		DrawText(pushAbility->IsReady() ? "ABILITY READY" : "COOLDOWN", uiX + 5, uiY + 5, 20, WHITE);
 	}
+
+	RenderProfiler();
+	RenderMemory();
+}
+
+void ModulePhysics::RenderProfiler()
+{
+	const Profiler& profiler = App->GetProfiler();
+
+	// Collect every (module, phase) pair that ran and sort by p99, worst first
+	struct Row { int slot; ProfilePhase phase; float p99; };
+	Row rows[64];
+	int rowCount = 0;
+	for (int slot = 0; slot < profiler.GetSlotCount(); ++slot)
+	{
+		for (int p = 0; p < PHASE_COUNT && rowCount < 64; ++p)
+		{
+			const ProfileStats& stats = profiler.GetStats(slot, (ProfilePhase)p);
+			if (stats.samples == 0) continue;
+			rows[rowCount++] = { slot, (ProfilePhase)p, stats.p99Ms };
+		}
+	}
+	std::sort(rows, rows + rowCount, [](const Row& a, const Row& b) { return a.p99 > b.p99; });
+	if (rowCount > PROFILER_OVERLAY_ROWS) rowCount = PROFILER_OVERLAY_ROWS;
+
+	int panelW = 520;
+	int panelH = 142 + rowCount * 18;
+	int panelX = 10;
+	int panelY = GetScreenHeight() - panelH - 10;
+
+	DrawRectangle(panelX, panelY, panelW, panelH, Fade(BLACK, 0.85f));
+	DrawRectangleLines(panelX, panelY, panelW, panelH, SKYBLUE);
+
+	const ProfileStats& frame = profiler.GetFrameStats();
+	DrawText(TextFormat("=== PROFILER === %u FPS", App->GetFramesLastSecond()), panelX + 10, panelY + 8, 16, SKYBLUE);
+	DrawText(TextFormat("Frame ms  min %.2f  avg %.2f  p99 %.2f  max %.2f", frame.minMs, frame.avgMs, frame.p99Ms, frame.maxMs), panelX + 10, panelY + 28, 14, WHITE);
+	DrawText(TextFormat("Startup ms  first frame %.0f  race start %.0f", App->GetTimeToFirstFrame() * 1000.0, App->GetTimeToRaceStart() * 1000.0), panelX + 10, panelY + 46, 14, WHITE);
+	const EventStats& events = App->events->GetFrameStats();
+	DrawText(TextFormat("Events  contacts %u (%u spilled)  shakes %u  sounds %u  dropped %u  %.3f ms", events.contacts, events.contactSpills,
+		events.screenShakes, events.sounds, events.dropped, events.dispatchMs),
+		panelX + 10, panelY + 64, 14, (events.dropped > 0 || events.contactSpills > 0) ? RED : WHITE);
+	const FramePacer& pacer = App->GetFramePacer();
+	DrawText(TextFormat("Pacing %s (F3)  work %.1f  sleep %.1f  latency %.1f ms", FramePacer::GetModeName(pacer.GetMode()),
+		pacer.GetWorkMs(), pacer.GetSleepMs(), pacer.GetInputToPresentMs()), panelX + 10, panelY + 82, 14, WHITE);
+	const QualityGovernor& governor = App->GetQualityGovernor();
+	DrawText(TextFormat("Quality %s (%s)  work %.1f / %.1f ms budget", QualityGovernor::GetLevelName(governor.GetLevel()),
+		governor.IsAdaptive() ? "auto" : "fixed", governor.GetSmoothedWorkMs(), pacer.GetFrameBudgetMs()), panelX + 10, panelY + 100, 14, WHITE);
+	DrawText("Module / phase                 min     avg     p99", panelX + 10, panelY + 120, 14, GRAY);
+
+	for (int i = 0; i < rowCount; ++i)
+	{
+		const ProfileStats& stats = profiler.GetStats(rows[i].slot, rows[i].phase);
+		int rowY = panelY + 138 + i * 18;
+		Color color = (stats.p99Ms > FIXED_TIMESTEP * 1000.0f * 0.5f) ? RED : (stats.p99Ms > 2.0f ? YELLOW : WHITE);
+
+		DrawText(TextFormat("%s.%s", profiler.GetSlotName(rows[i].slot), Profiler::GetPhaseName(rows[i].phase)), panelX + 10, rowY, 14, color);
+		DrawText(TextFormat("%6.2f  %6.2f  %6.2f", stats.minMs, stats.avgMs, stats.p99Ms), panelX + 230, rowY, 14, color);
+	}
+}
+
+// Heap allocations per subsystem: last frame, race frames after warm-up, and live bytes
+void ModulePhysics::RenderMemory()
+{
+	const MemoryCounters& frame = App->GetFrameMemory();
+	const MemoryCounters& race = App->GetRaceMemory();
+
+	int panelW = 400;
+	int panelH = 48 + MEM_TAG_COUNT * 18;
+	int panelX = GetScreenWidth() - panelW - 10;
+	int panelY = GetScreenHeight() - panelH - 10;
+
+	DrawRectangle(panelX, panelY, panelW, panelH, Fade(BLACK, 0.85f));
+	DrawRectangleLines(panelX, panelY, panelW, panelH, SKYBLUE);
+
+	DrawText(TextFormat("=== HEAP === %llu / %llu race frames allocated", (unsigned long long)App->GetRaceFramesAllocating(), (unsigned long long)App->GetRaceFramesMeasured()), panelX + 10, panelY + 8, 16, SKYBLUE);
+	DrawText("Subsystem     frame  bytes    race    live KB", panelX + 10, panelY + 28, 14, GRAY);
+
+	for (int tag = 0; tag < MEM_TAG_COUNT; ++tag)
+	{
+		int rowY = panelY + 46 + tag * 18;
+		Color color = (frame.calls[tag] > 0) ? YELLOW : (race.calls[tag] > 0 ? ORANGE : WHITE);
+
+		DrawText(memory_tag_name((MemoryTag)tag), panelX + 10, rowY, 14, color);
+		DrawText(TextFormat("%5llu %6llu %7llu %9.1f", (unsigned long long)frame.calls[tag], (unsigned long long)frame.bytes[tag],
+			(unsigned long long)race.calls[tag], frame.live[tag] / 1024.0), panelX + 110, rowY, 14, color);
+	}
 }
 
 void ModulePhysics::HandleMouseJoint()
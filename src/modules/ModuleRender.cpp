@@ -33,6 +33,8 @@ bool ModuleRender::Init()
 
 bool ModuleRender::Start()
 {
+    shakeRandom.Seed(App->GetRandomSeed(), RandomStreamId(RANDOM_STREAM_CAMERA));
+
     // Initialize camera centered on player at start
     UpdateCamera();
     return true;
@@ -55,8 +57,9 @@ update_status ModuleRender::Update()
     Vector2 shakeOffset = {0, 0};
     if (screenShakeAmount > 0)
     {
-        shakeOffset.x = GetRandomValue(-screenShakeAmount, screenShakeAmount);
-        shakeOffset.y = GetRandomValue(-screenShakeAmount, screenShakeAmount);
+        int shake = (int)screenShakeAmount;
+        shakeOffset.x = (float)shakeRandom.Range(-shake, shake);
+        shakeOffset.y = (float)shakeRandom.Range(-shake, shake);
     }
     camera.offset.x = (float)SCREEN_WIDTH * 0.5f + shakeOffset.x;
     camera.offset.y = (float)SCREEN_HEIGHT * 0.5f + shakeOffset.y;
@@ -127,6 +130,13 @@ update_status ModuleRender::PostUpdate()
             }
         }
 
+        // Fast-forward indicator, whatever the race state
+        if (App->GetTimeScale() > 1)
+        {
+            const char* text = TextFormat(">> x%d", App->GetTimeScale());
+            ::DrawText(text, SCREEN_WIDTH - MeasureText(text, 24) - 20, SCREEN_HEIGHT - 44, 24, YELLOW);
+        }
+
         // Render win screen in screen space (covers everything)
         if (App->checkpointManager && App->checkpointManager->IsRaceFinished())
         {
@@ -134,7 +144,7 @@ update_status ModuleRender::PostUpdate()
         }
     }
 
-    EndDrawing();
+    App->GetFramePacer().Present();
     return UPDATE_CONTINUE;
 }
 
@@ -151,7 +161,7 @@ void ModuleRender::SetBackgroundColor(Color color)
 void ModuleRender::HandleCameraInput()
 {
     // Cycle through camera modes with C key
-    if (IsKeyPressed(KEY_C))
+    if (App->IsKeyPressed(KEY_C))
     {
         if (cameraMode == CAMERA_FOLLOW_CAR)
         {
@@ -184,7 +194,7 @@ void ModuleRender::UpdateCamera()
     // Update screen shake
     if (screenShakeAmount > 0)
     {
-        screenShakeAmount -= 50.0f * GetFrameTime(); // Reduce over time
+        screenShakeAmount -= 50.0f * App->GetFrameDelta(); // Reduce over time
         if (screenShakeAmount < 0) screenShakeAmount = 0;
     }
 
@@ -202,13 +212,13 @@ void ModuleRender::UpdateCamera()
         if (!App->player || !App->player->GetCar())
             return;
 
-        // Get player car position and rotation
+        // Get player car position and rotation (interpolated between simulation steps)
         float playerX, playerY;
-        App->player->GetCar()->GetPosition(playerX, playerY);
-        float playerRotation = App->player->GetCar()->GetRotation();
+        App->player->GetCar()->GetRenderPosition(playerX, playerY);
+        float playerRotation = App->player->GetCar()->GetRenderRotation();
 
-        // Smooth camera target
-        float smoothSpeed = 0.125f;
+        // Smooth camera target - 0.125 per 60Hz frame, scaled so any refresh rate feels the same
+        float smoothSpeed = 1.0f - powf(1.0f - 0.125f, App->GetFrameDelta() * 60.0f);
         camera.target.x = camera.target.x + (playerX - camera.target.x) * smoothSpeed;
         camera.target.y = camera.target.y + (playerY - camera.target.y) * smoothSpeed;
 
@@ -226,7 +236,7 @@ void ModuleRender::UpdateCamera()
 
         // Get player car position
         float playerX, playerY;
-        App->player->GetCar()->GetPosition(playerX, playerY);
+        App->player->GetCar()->GetRenderPosition(playerX, playerY);
 
         // Set camera target to player position
         camera.target = { playerX, playerY };
@@ -246,8 +256,8 @@ void ModuleRender::UpdateCamera()
         
         if (App && App->map)
         {
-            mapWidth = (float)App->map->mapData.width;
-            mapHeight = (float)App->map->mapData.height;
+            mapWidth = (float)App->map->GetMapData().width;
+            mapHeight = (float)App->map->GetMapData().height;
         }
         
         // Screen dimensions: 1280x720 pixels
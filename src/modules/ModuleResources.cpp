@@ -1,6 +1,8 @@
 #include "core/Globals.h"
 #include "core/Application.h"
 #include "modules/ModuleResources.h"
+#include "modules/ModuleAudio.h"
+#include "core/Trace.h"
 #include <algorithm>
 
 ModuleResources::ModuleResources(Application* app, bool start_enabled) : Module(app, start_enabled)
@@ -11,6 +13,12 @@ ModuleResources::~ModuleResources()
 {
 }
 
+// Only touched from Start/CleanUp and the main-thread draw phase
+void ModuleResources::DeclareAccess()
+{
+	Writes({});
+}
+
 bool ModuleResources::Init()
 {
 	LOG("Initializing Resource Manager");
@@ -38,9 +46,18 @@ std::string ModuleResources::NormalizePath(const char* path) const
 // Texture loading and management
 Texture2D ModuleResources::LoadTexture(const char* path)
 {
+	MemoryScope memory(MEM_RESOURCES);
+	TRACE_ZONE("ModuleResources::LoadTexture");
+
 	if (path == nullptr)
 	{
-		LOG("ERROR: Attempted to load texture with null path");
+		LOG_ERR("Attempted to load texture with null path");
+		return Texture2D{ 0 };
+	}
+
+	// Headless runs have no GPU - hand back an empty texture, nothing will draw it
+	if (App->IsHeadless())
+	{
 		return Texture2D{ 0 };
 	}
 
@@ -54,13 +71,27 @@ Texture2D ModuleResources::LoadTexture(const char* path)
 		return textures[normalizedPath];
 	}
 
-	// Load the texture from raylib
-	LOG("Loading texture: %s", path);
-	Texture2D texture = ::LoadTexture(path);
+	// Upload a preloaded image, or load the texture from raylib
+	Texture2D texture = { 0 };
+	auto pending = pendingImages.find(normalizedPath);
+	if (pending != pendingImages.end())
+	{
+		LOG("Loading preloaded texture: %s", path);
+		Image image = pending->second.get();
+		pendingImages.erase(pending);
+
+		if (image.data != nullptr) texture = ::LoadTextureFromImage(image);
+		::UnloadImage(image);
+	}
+	else
+	{
+		LOG("Loading texture: %s", path);
+		texture = ::LoadTexture(path);
+	}
 
 	if (texture.id == 0)
 	{
-		LOG("ERROR: Failed to load texture: %s", path);
+		LOG_ERR("Failed to load texture: %s", path);
 		return Texture2D{ 0 };
 	}
 
@@ -72,9 +103,26 @@ Texture2D ModuleResources::LoadTexture(const char* path)
 	return texture;
 }
 
+void ModuleResources::PreloadTexture(const char* path)
+{
+	MemoryScope memory(MEM_RESOURCES);
+	if (path == nullptr || App->IsHeadless())
+		return;
+
+	std::string normalizedPath = NormalizePath(path);
+	if (textures.find(normalizedPath) != textures.end() || pendingImages.find(normalizedPath) != pendingImages.end())
+		return;
+
+	// Only file reading and decoding happen off the main thread, GPU upload waits for LoadTexture
+	std::string filePath(path);
+	pendingImages[normalizedPath] = std::async(std::launch::async, [filePath]() {
+		return ::LoadImage(filePath.c_str());
+	});
+}
+
 void ModuleResources::UnloadTexture(const char* path)
 {
-	if (path == nullptr)
+	if (path == nullptr || App->IsHeadless())
 		return;
 
 	std::string normalizedPath = NormalizePath(path);
@@ -82,7 +130,7 @@ void ModuleResources::UnloadTexture(const char* path)
 	auto it = textures.find(normalizedPath);
 	if (it == textures.end())
 	{
-		LOG("WARNING: Attempted to unload texture that was not loaded: %s", path);
+		LOG_WARN("Attempted to unload texture that was not loaded: %s", path);
 		return;
 	}
 
@@ -122,6 +170,13 @@ void ModuleResources::UnloadAllTextures()
 	}
 	textures.clear();
 	textureRefCount.clear();
+
+	// Preloaded images nobody asked for
+	for (auto& pair : pendingImages)
+	{
+		::UnloadImage(pair.second.get());
+	}
+	pendingImages.clear();
 }
 
 int ModuleResources::GetTextureCount() const
@@ -132,9 +187,16 @@ int ModuleResources::GetTextureCount() const
 // Sound loading and management
 Sound ModuleResources::LoadSound(const char* path)
 {
+	MemoryScope memory(MEM_RESOURCES);
 	if (path == nullptr)
 	{
-		LOG("ERROR: Attempted to load sound with null path");
+		LOG_ERR("Attempted to load sound with null path");
+		return Sound{ 0 };
+	}
+
+	// Headless runs have no audio device, and a windowed one may still be opening
+	if (App->IsHeadless() || !App->audio->WaitForDevice())
+	{
 		return Sound{ 0 };
 	}
 
@@ -154,7 +216,7 @@ Sound ModuleResources::LoadSound(const char* path)
 
 	if (sound.stream.buffer == nullptr)
 	{
-		LOG("ERROR: Failed to load sound: %s", path);
+		LOG_ERR("Failed to load sound: %s", path);
 		return Sound{ 0 };
 	}
 
@@ -168,7 +230,7 @@ Sound ModuleResources::LoadSound(const char* path)
 
 void ModuleResources::UnloadSound(const char* path)
 {
-	if (path == nullptr)
+	if (path == nullptr || App->IsHeadless())
 		return;
 
 	std::string normalizedPath = NormalizePath(path);
@@ -176,7 +238,7 @@ void ModuleResources::UnloadSound(const char* path)
 	auto it = sounds.find(normalizedPath);
 	if (it == sounds.end())
 	{
-		LOG("WARNING: Attempted to unload sound that was not loaded: %s", path);
+		LOG_WARN("Attempted to unload sound that was not loaded: %s", path);
 		return;
 	}
 
@@ -226,9 +288,16 @@ int ModuleResources::GetSoundCount() const
 // Music loading and management
 Music ModuleResources::LoadMusic(const char* path)
 {
+	MemoryScope memory(MEM_RESOURCES);
 	if (path == nullptr)
 	{
-		LOG("ERROR: Attempted to load music with null path");
+		LOG_ERR("Attempted to load music with null path");
+		return Music{ 0 };
+	}
+
+	// Headless runs have no audio device, and a windowed one may still be opening
+	if (App->IsHeadless() || !App->audio->WaitForDevice())
+	{
 		return Music{ 0 };
 	}
 
@@ -247,7 +316,7 @@ Music ModuleResources::LoadMusic(const char* path)
 
 	if (!IsMusicValid(music))
 	{
-		LOG("ERROR: Failed to load music: %s", path);
+		LOG_ERR("Failed to load music: %s", path);
 		return Music{ 0 };
 	}
 
@@ -260,7 +329,7 @@ Music ModuleResources::LoadMusic(const char* path)
 
 void ModuleResources::UnloadMusic(const char* path)
 {
-	if (path == nullptr)
+	if (path == nullptr || App->IsHeadless())
 		return;
 
 	std::string normalizedPath = NormalizePath(path);
@@ -268,7 +337,7 @@ void ModuleResources::UnloadMusic(const char* path)
 	auto it = musics.find(normalizedPath);
 	if (it == musics.end())
 	{
-		LOG("WARNING: Attempted to unload music that was not loaded: %s", path);
+		LOG_WARN("Attempted to unload music that was not loaded: %s", path);
 		return;
 	}
 
@@ -19,7 +19,7 @@ bool ModuleWindow::Init()
 	bool fullscreen = WIN_FULLSCREEN;
 	bool borderless = WIN_BORDERLESS;
 	bool resizable = WIN_RESIZABLE;
-	bool vsync = VSYNC;
+	bool vsync = VSYNC && App->GetConfig().framePacing != FRAME_PACING_UNCAPPED;
 
 	width = SCREEN_WIDTH;
 	height = SCREEN_HEIGHT;
@@ -37,9 +37,11 @@ bool ModuleWindow::Init()
 	SetConfigFlags(flags);
 	InitWindow(width, height, TITLE);
 
-	// Set target FPS to 60
-	SetTargetFPS(60);
-	LOG("Target FPS set to 60");
+	// Escape leaves the race and the menus (Application, ModuleMainMenu) - closing is the window's job
+	SetExitKey(KEY_NULL);
+
+	// Frame cap and vsync follow the pacing mode from now on
+	App->GetFramePacer().Init(App->GetConfig().framePacing, App->GetConfig().frameCap);
 
 	return ret;
 }
@@ -0,0 +1,163 @@
+// logdecode - turns a binary log written with --log-file back into text
+//
+// Usage: logdecode FILE [--level debug|info|warning|error]
+// Prints one line per message: [seconds] file(line) : LEVEL: message
+
+#include "core/LogFormat.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define DECODE_LINE_SIZE 4096
+
+struct DecodedSite
+{
+	int level = 1;
+	uint32_t line = 0;
+	std::string file;
+	std::string format;
+};
+
+static bool ReadBytes(FILE* file, void* data, size_t bytes)
+{
+	return fread(data, 1, bytes, file) == bytes;
+}
+
+static bool ReadString(FILE* file, std::string& text)
+{
+	uint16_t length = 0;
+	if (!ReadBytes(file, &length, sizeof(length))) return false;
+
+	text.resize(length);
+	return length == 0 || ReadBytes(file, &text[0], length);
+}
+
+static int ParseLevel(const char* name)
+{
+	if (strcmp(name, "debug") == 0) return 0;
+	if (strcmp(name, "info") == 0) return 1;
+	if (strcmp(name, "warning") == 0) return 2;
+	if (strcmp(name, "error") == 0) return 3;
+
+	fprintf(stderr, "Unknown level '%s', showing everything\n", name);
+	return 0;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		fprintf(stderr, "Usage: %s FILE [--level debug|info|warning|error]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	int minLevel = 0;
+	for (int i = 2; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--level") == 0 && i + 1 < argc) minLevel = ParseLevel(argv[++i]);
+	}
+
+	FILE* file = fopen(argv[1], "rb");
+	if (file == nullptr)
+	{
+		fprintf(stderr, "Could not open '%s'\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	char magic[LOG_FILE_MAGIC_SIZE] = {};
+	if (!ReadBytes(file, magic, LOG_FILE_MAGIC_SIZE) || memcmp(magic, LOG_FILE_MAGIC, LOG_FILE_MAGIC_SIZE) != 0)
+	{
+		fprintf(stderr, "'%s' is not a binary game log\n", argv[1]);
+		fclose(file);
+		return EXIT_FAILURE;
+	}
+
+	std::unordered_map<uint32_t, DecodedSite> sites;
+	std::vector<uint8_t> payload;
+	char text[DECODE_LINE_SIZE];
+	int messages = 0;
+	bool truncated = false;
+
+	uint8_t type = 0;
+	while (ReadBytes(file, &type, 1))
+	{
+		if (type == LOG_RECORD_DROPPED)
+		{
+			uint32_t count = 0;
+			if (!ReadBytes(file, &count, sizeof(count))) { truncated = true; break; }
+			printf("%u log messages dropped (queue full)\n", count);
+			continue;
+		}
+
+		uint32_t id = 0;
+		if (!ReadBytes(file, &id, sizeof(id))) { truncated = true; break; }
+
+		if (type == LOG_RECORD_SITE)
+		{
+			DecodedSite site;
+			uint8_t level = 0;
+			if (!ReadBytes(file, &level, 1) || !ReadBytes(file, &site.line, sizeof(site.line)) ||
+				!ReadString(file, site.file) || !ReadString(file, site.format))
+			{
+				truncated = true;
+				break;
+			}
+			site.level = level;
+			sites[id] = site;
+			continue;
+		}
+
+		if (type != LOG_RECORD_MESSAGE && type != LOG_RECORD_SUPPRESSED)
+		{
+			fprintf(stderr, "Unknown record type %d, stopping\n", type);
+			truncated = true;
+			break;
+		}
+
+		int64_t timestampNs = 0;
+		if (!ReadBytes(file, &timestampNs, sizeof(timestampNs))) { truncated = true; break; }
+
+		if (type == LOG_RECORD_MESSAGE)
+		{
+			uint16_t size = 0;
+			if (!ReadBytes(file, &size, sizeof(size))) { truncated = true; break; }
+			payload.resize(size);
+			if (size > 0 && !ReadBytes(file, payload.data(), size)) { truncated = true; break; }
+		}
+		else
+		{
+			uint32_t count = 0;
+			if (!ReadBytes(file, &count, sizeof(count))) { truncated = true; break; }
+			snprintf(text, sizeof(text), "(%u similar messages suppressed)", count);
+		}
+
+		auto found = sites.find(id);
+		if (found == sites.end())
+		{
+			fprintf(stderr, "Record for unknown site %u skipped\n", id);
+			continue;
+		}
+
+		const DecodedSite& site = found->second;
+		if (site.level < minLevel) continue;
+
+		if (type == LOG_RECORD_MESSAGE)
+		{
+			log_format_payload(site.format.c_str(), payload.data(), payload.size(), text, sizeof(text));
+		}
+
+		printf("[%10.4f] %s(%u) : %s%s\n", timestampNs / 1e9, site.file.c_str(), site.line, log_level_prefix(site.level), text);
+		messages++;
+	}
+
+	fclose(file);
+
+	// A log from a game that crashed ends mid-record - everything before it is still good
+	if (truncated) fprintf(stderr, "Log ends with an incomplete record\n");
+	fprintf(stderr, "%d messages, %d call sites\n", messages, (int)sites.size());
+	return EXIT_SUCCESS;
+}
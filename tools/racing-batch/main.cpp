@@ -0,0 +1,262 @@
+// racing-batch - runs many AI-only races headless, in parallel, and writes the results to CSV
+//
+// Usage: racing-batch [--races N] [--seed S] [--jobs J] [--steps N] [--out FILE] [--frames FILE]
+//   --races N     races to run (default 16)
+//   --seed S      seed of the first race, race i uses S + i (default 1)
+//   --jobs J      races running at the same time (default: hardware threads)
+//   --steps N     give up on a race after N simulation steps (default: 10 simulated minutes)
+//   --out FILE    one row per car: lap times and finishing position (default racing-batch.csv)
+//   --frames FILE one row per simulation step: its cost in microseconds (off by default)
+//
+// Every row carries the race's final state hash (Application::GetStateHash): two batches
+// with the same seeds must produce the same hashes whatever --jobs, as long as they run on the
+// same platform and toolchain - floating-point contraction and the C runtime's sinf / cosf /
+// atan2f differ between compilers and platforms, and so may the races.
+//
+// Every race is its own Application (physics world, entities, RNG) stepped on one thread,
+// so races don't wait on each other and a seed always produces the same race.
+// Run it from the game's root folder - the races load assets/ like the game does.
+
+#include "core/Application.h"
+#include "core/Globals.h"
+#include "core/Trace.h"
+#include "core/Timer.h"
+#include "entities/CheckpointManager.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct BatchOptions
+{
+	int races = 16;
+	uint32 seed = 1;
+	int jobs = 0;
+	uint64 maxSteps = 0;
+	const char* outPath = "racing-batch.csv";
+	const char* framesPath = nullptr;
+};
+
+struct CarResult
+{
+	std::string name;
+	int place = 0;
+	double finishSec = 0.0;
+	std::vector<double> lapSec;
+};
+
+struct RaceResult
+{
+	int index = 0;
+	uint32 seed = 0;
+	bool ok = false;
+	uint64 steps = 0;
+	uint64_t stateHash = 0;
+	double wallSec = 0.0;
+	double avgStepUs = 0.0;
+	double p99StepUs = 0.0;
+	double maxStepUs = 0.0;
+	std::vector<CarResult> cars;
+	std::vector<float> stepUs;
+};
+
+static bool ParseCommandLine(int argc, char** argv, BatchOptions& options)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		bool hasValue = i + 1 < argc;
+		if (strcmp(argv[i], "--races") == 0 && hasValue) options.races = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--seed") == 0 && hasValue) options.seed = (uint32)strtoul(argv[++i], NULL, 10);
+		else if (strcmp(argv[i], "--jobs") == 0 && hasValue) options.jobs = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--steps") == 0 && hasValue) options.maxSteps = strtoull(argv[++i], NULL, 10);
+		else if (strcmp(argv[i], "--out") == 0 && hasValue) options.outPath = argv[++i];
+		else if (strcmp(argv[i], "--frames") == 0 && hasValue) options.framesPath = argv[++i];
+		else
+		{
+			fprintf(stderr, "Unknown option '%s'\n", argv[i]);
+			return false;
+		}
+	}
+	return options.races > 0;
+}
+
+static void RunRace(const BatchOptions& options, RaceResult& result)
+{
+	AppConfig config;
+	config.headless = true;
+	config.aiOnly = true;
+	config.randomSeed = result.seed;
+	config.maxSteps = options.maxSteps;
+	config.workerThreads = 0;   // The batch already keeps every core busy with races
+	config.stateHash = true;
+
+	Application* app = new Application(config);
+
+	Timer raceTime;
+	if (app->Init())
+	{
+		result.ok = true;
+		while (true)
+		{
+			Timer stepTime;
+			update_status status = app->Update();
+			result.stepUs.push_back((float)stepTime.ReadUs());
+
+			if (status == UPDATE_ERROR) result.ok = false;
+			if (status != UPDATE_CONTINUE) break;
+		}
+	}
+	result.wallSec = raceTime.ReadSec();
+	result.steps = app->GetSimulationStep();
+	result.stateHash = app->GetStateHash();
+
+	for (const CarProgress& progress : app->checkpointManager->GetCarProgress())
+	{
+		CarResult car;
+		car.name = progress.name;
+		car.place = progress.place;
+		car.finishSec = progress.place > 0 ? progress.finishStep * (double)FIXED_TIMESTEP : 0.0;
+		for (uint64 lapSteps : progress.lapSteps)
+		{
+			car.lapSec.push_back(lapSteps * (double)FIXED_TIMESTEP);
+		}
+		result.cars.push_back(car);
+	}
+
+	app->CleanUp();
+	delete app;
+
+	// Step cost summary
+	if (!result.stepUs.empty())
+	{
+		std::vector<float> sorted = result.stepUs;
+		std::sort(sorted.begin(), sorted.end());
+
+		double total = 0.0;
+		for (float us : sorted) total += us;
+
+		result.avgStepUs = total / sorted.size();
+		result.p99StepUs = sorted[(size_t)((sorted.size() - 1) * 0.99)];
+		result.maxStepUs = sorted.back();
+	}
+	if (options.framesPath == nullptr)
+	{
+		std::vector<float>().swap(result.stepUs);
+	}
+}
+
+static bool WriteResults(const BatchOptions& options, const std::vector<RaceResult>& results)
+{
+	FILE* file = fopen(options.outPath, "w");
+	if (file == nullptr)
+	{
+		fprintf(stderr, "Could not write '%s'\n", options.outPath);
+		return false;
+	}
+
+	size_t maxLaps = 0;
+	for (const RaceResult& race : results)
+	{
+		for (const CarResult& car : race.cars) maxLaps = std::max(maxLaps, car.lapSec.size());
+	}
+
+	fprintf(file, "race,seed,ok,steps,state_hash,wall_s,step_avg_us,step_p99_us,step_max_us,car,place,finish_s");
+	for (size_t lap = 0; lap < maxLaps; ++lap) fprintf(file, ",lap%d_s", (int)lap + 1);
+	fprintf(file, "\n");
+
+	for (const RaceResult& race : results)
+	{
+		for (const CarResult& car : race.cars)
+		{
+			fprintf(file, "%d,%u,%d,%llu,%016llx,%.3f,%.1f,%.1f,%.1f,%s,%d,%.3f",
+				race.index, race.seed, race.ok ? 1 : 0, (unsigned long long)race.steps,
+				(unsigned long long)race.stateHash, race.wallSec,
+				race.avgStepUs, race.p99StepUs, race.maxStepUs, car.name.c_str(), car.place, car.finishSec);
+			for (size_t lap = 0; lap < maxLaps; ++lap)
+			{
+				if (lap < car.lapSec.size()) fprintf(file, ",%.3f", car.lapSec[lap]);
+				else fprintf(file, ",");
+			}
+			fprintf(file, "\n");
+		}
+	}
+
+	fclose(file);
+
+	if (options.framesPath == nullptr)
+		return true;
+
+	file = fopen(options.framesPath, "w");
+	if (file == nullptr)
+	{
+		fprintf(stderr, "Could not write '%s'\n", options.framesPath);
+		return false;
+	}
+
+	fprintf(file, "race,step,us\n");
+	for (const RaceResult& race : results)
+	{
+		for (size_t step = 0; step < race.stepUs.size(); ++step)
+		{
+			fprintf(file, "%d,%d,%.1f\n", race.index, (int)step, race.stepUs[step]);
+		}
+	}
+	fclose(file);
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	BatchOptions options;
+	if (!ParseCommandLine(argc, argv, options))
+	{
+		fprintf(stderr, "Usage: %s [--races N] [--seed S] [--jobs J] [--steps N] [--out FILE] [--frames FILE]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	int jobs = options.jobs > 0 ? options.jobs : (int)std::thread::hardware_concurrency();
+	jobs = std::max(1, std::min(jobs, options.races));
+
+	std::vector<RaceResult> results(options.races);
+	for (int i = 0; i < options.races; ++i)
+	{
+		results[i].index = i;
+		results[i].seed = options.seed + (uint32)i;
+	}
+
+	LOG("racing-batch: %d races on %d threads (seeds %u..%u)", options.races, jobs, options.seed, options.seed + (uint32)options.races - 1);
+	Timer batchTime;
+
+	// Each thread takes the next race until none are left
+	std::atomic<int> nextRace(0);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < jobs; ++t)
+	{
+		threads.emplace_back([&]() {
+			trace_set_thread_name("Race Runner");
+			for (int race = nextRace++; race < options.races; race = nextRace++)
+			{
+				RunRace(options, results[race]);
+			}
+		});
+	}
+	for (std::thread& thread : threads) thread.join();
+
+	double wallSec = batchTime.ReadSec();
+
+	int failed = 0;
+	for (const RaceResult& race : results) if (!race.ok) failed++;
+
+	bool written = WriteResults(options, results);
+	LOG("racing-batch: %d races in %.1fs (%.1f races/min), %d failed, results in '%s'",
+		options.races, wallSec, wallSec > 0.0 ? options.races * 60.0 / wallSec : 0.0, failed, options.outPath);
+	time_accumulators_log();
+
+	log_shutdown();
+	return (written && failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}